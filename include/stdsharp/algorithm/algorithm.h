@@ -1,15 +1,37 @@
 #pragma once
 
 #include "../compare/compare.h"
+#include "../execution/parallel_policy.h"
 #include "../functional/operations.h"
 
 #include <algorithm>
+#include <atomic>
 #include <gsl/gsl>
+#include <vector>
 
 namespace stdsharp
 {
     inline constexpr struct set_if_fn
     {
+    private:
+        template<typename T, typename Atomic, typename Comp>
+        static T atomic_set_if(Atomic& left, const T desired, Comp& comp)
+        {
+            auto current = left.load(std::memory_order_relaxed);
+
+            while(invoke(comp, desired, current))
+                if(left.compare_exchange_weak(
+                       current,
+                       desired,
+                       std::memory_order_acq_rel,
+                       std::memory_order_relaxed
+                   ))
+                    return desired;
+
+            return current;
+        }
+
+    public:
         template<typename T, typename U, std::predicate<U, T> Comp>
             requires std::assignable_from<T&, U>
         constexpr T& operator()(T& left, U&& right, Comp comp = {}) const
@@ -18,6 +40,54 @@ namespace stdsharp
             if(invoke(cpp_move(comp), right, left)) left = cpp_forward(right);
             return left;
         }
+
+        // cas loop that only writes when comp(right, current) holds, returns the value held after
+        // the operation
+        template<typename T, std::convertible_to<T> U, std::predicate<const T&, const T&> Comp>
+        T operator()(std::atomic<T>& left, U&& right, Comp comp = {}) const
+        {
+            return atomic_set_if<T>(left, cpp_forward(right), comp);
+        }
+
+        template<typename T, std::convertible_to<T> U, std::predicate<const T&, const T&> Comp>
+        T operator()(const std::atomic_ref<T> left, U&& right, Comp comp = {}) const
+        {
+            return atomic_set_if<T>(left, cpp_forward(right), comp);
+        }
+
+        // same as applying set_if with every element of the range in order, comp must be a strict
+        // weak order so that chunk results can be reduced independently
+        template<
+            typename Executor,
+            typename T,
+            std::ranges::random_access_range R,
+            typename Comp,
+            typename Ref = std::ranges::range_reference_t<R>>
+            requires std::ranges::sized_range<R> && std::predicate<Comp&, Ref, Ref> &&
+            std::predicate<Comp&, Ref, T&> && std::assignable_from<T&, Ref>
+        T& operator()(const parallel_policy<Executor>& policy, T& left, R&& range, Comp comp) const
+        {
+            const auto size = static_cast<std::size_t>(std::ranges::size(range));
+            const auto begin = std::ranges::begin(range);
+            std::vector<std::size_t> best(policy.chunk_count(size), size);
+
+            policy.for_each_chunk(
+                size,
+                [&](const std::size_t first, const std::size_t last, const std::size_t index)
+                {
+                    if(first == last) return;
+
+                    auto& current = best[index] = first;
+                    for(auto i = first + 1; i < last; ++i)
+                        if(invoke(comp, begin[i], begin[current])) current = i;
+                }
+            );
+
+            for(const auto i : best)
+                if(i != size) (*this)(left, begin[i], std::ref(comp));
+
+            return left;
+        }
     } set_if{};
 
     inline constexpr struct set_if_greater_fn
@@ -29,6 +99,28 @@ namespace stdsharp
         {
             return set_if(left, cpp_forward(right), greater_v);
         }
+
+        template<typename T, typename U>
+            requires std::invocable<set_if_fn, std::atomic<T>&, U, std::ranges::greater>
+        T operator()(std::atomic<T>& left, U&& right) const
+        {
+            return set_if(left, cpp_forward(right), greater_v);
+        }
+
+        template<typename T, typename U>
+            requires std::invocable<set_if_fn, std::atomic_ref<T>, U, std::ranges::greater>
+        T operator()(const std::atomic_ref<T> left, U&& right) const
+        {
+            return set_if(left, cpp_forward(right), greater_v);
+        }
+
+        template<typename Executor, typename T, typename R>
+            requires std::
+                invocable<set_if_fn, const parallel_policy<Executor>&, T&, R, std::ranges::greater>
+        T& operator()(const parallel_policy<Executor>& policy, T& left, R&& range) const
+        {
+            return set_if(policy, left, cpp_forward(range), greater_v);
+        }
     } set_if_greater{};
 
     inline constexpr struct set_if_less_fn
@@ -40,6 +132,28 @@ namespace stdsharp
         {
             return set_if(left, cpp_forward(right), less_v);
         }
+
+        template<typename T, typename U>
+            requires std::invocable<set_if_fn, std::atomic<T>&, U, std::ranges::less>
+        T operator()(std::atomic<T>& left, U&& right) const
+        {
+            return set_if(left, cpp_forward(right), less_v);
+        }
+
+        template<typename T, typename U>
+            requires std::invocable<set_if_fn, std::atomic_ref<T>, U, std::ranges::less>
+        T operator()(const std::atomic_ref<T> left, U&& right) const
+        {
+            return set_if(left, cpp_forward(right), less_v);
+        }
+
+        template<typename Executor, typename T, typename R>
+            requires std::
+                invocable<set_if_fn, const parallel_policy<Executor>&, T&, R, std::ranges::less>
+        T& operator()(const parallel_policy<Executor>& policy, T& left, R&& range) const
+        {
+            return set_if(policy, left, cpp_forward(range), less_v);
+        }
     } set_if_less{};
 
     inline constexpr struct is_between_fn
@@ -142,6 +256,54 @@ namespace stdsharp
                 cmp
             );
         }
+
+        // chunk orderings are reduced the same way as elements, which is associative. the first
+        // unordered chunk stops the others early
+        template<
+            typename Executor,
+            std::ranges::random_access_range R1,
+            std::ranges::random_access_range R2,
+            typename Cmp = std::compare_three_way>
+            requires std::ranges::sized_range<R1> && std::ranges::sized_range<R2> &&
+            ordering_predicate<
+                Cmp&,
+                std::ranges::range_reference_t<R1>,
+                std::ranges::range_reference_t<R2>>
+        auto operator()(const parallel_policy<Executor>& policy, R1&& r1, R2&& r2, Cmp cmp = {})
+            const
+        {
+            const auto size = static_cast<std::size_t>(std::ranges::size(r1));
+
+            if(size != static_cast<std::size_t>(std::ranges::size(r2))) return ordering::unordered;
+
+            const auto begin1 = std::ranges::begin(r1);
+            const auto begin2 = std::ranges::begin(r2);
+            std::vector<ordering> results(policy.chunk_count(size), ordering::equivalent);
+            std::atomic_bool stop{false};
+
+            policy.for_each_chunk(
+                size,
+                [&](const std::size_t first, const std::size_t last, const std::size_t index)
+                {
+                    auto pre = ordering::equivalent;
+
+                    for(auto i = first; i < last && !is_ud(pre); ++i)
+                    {
+                        if(stop.load(std::memory_order_relaxed)) return;
+                        cmp_impl(pre, invoke(cmp, begin1[i], begin2[i]));
+                    }
+
+                    if(is_ud(pre)) stop.store(true, std::memory_order_relaxed);
+                    results[index] = pre;
+                }
+            );
+
+            if(stop.load(std::memory_order_relaxed)) return ordering::unordered;
+
+            auto pre = ordering::equivalent;
+            for(const auto result : results) cmp_impl(pre, result);
+            return pre;
+        }
     } strict_compare{};
 
     template<typename In, typename Out>
@@ -158,5 +320,33 @@ namespace stdsharp
 
             return {cpp_move(r).in.base(), cpp_move(r).out};
         }
+
+        template<typename Executor, std::random_access_iterator In, std::random_access_iterator Out>
+            requires std::indirectly_movable<In, Out>
+        move_n_result<In, Out> operator()(
+            const parallel_policy<Executor>& policy,
+            const In in,
+            const std::iter_difference_t<In> n,
+            const Out out
+        ) const
+        {
+            Expects(n >= 0);
+
+            policy.for_each_chunk(
+                static_cast<std::size_t>(n),
+                [in, out](const std::size_t first, const std::size_t last, const std::size_t)
+                {
+                    const auto offset = static_cast<std::iter_difference_t<In>>(first);
+
+                    std::ranges::move(
+                        in + offset,
+                        in + static_cast<std::iter_difference_t<In>>(last),
+                        out + static_cast<std::iter_difference_t<Out>>(offset)
+                    );
+                }
+            );
+
+            return {in + n, out + static_cast<std::iter_difference_t<Out>>(n)};
+        }
     } move_n{};
 }
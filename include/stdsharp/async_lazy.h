@@ -0,0 +1,90 @@
+#pragma once
+
+#include "concurrent_lazy.h"
+#include "functional/invoke.h"
+
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace stdsharp
+{
+    template<std::invocable Fn>
+    class async_lazy
+    {
+        using lazy_t = concurrent_lazy<Fn>;
+
+    public:
+        using value_type = lazy_t::value_type;
+
+        class task
+        {
+            std::shared_ptr<lazy_t> lazy_;
+
+        public:
+            explicit task(std::shared_ptr<lazy_t> lazy) noexcept: lazy_(cpp_move(lazy)) {}
+
+            void operator()() const noexcept
+            {
+                // a failed initialization leaves the lazy empty, so the exception is rethrown by
+                // the initializer call that get() runs afterwards
+                try
+                {
+                    lazy_->get();
+                }
+                catch(...) // NOLINT(*-empty-catch)
+                {
+                }
+            }
+        };
+
+    private:
+        std::shared_ptr<lazy_t> lazy_;
+        std::atomic_flag started_;
+        std::jthread worker_;
+
+    public:
+        template<typename... Args>
+            requires std::constructible_from<Fn, Args...>
+        explicit(sizeof...(Args) == 1) async_lazy(Args&&... args):
+            lazy_(std::make_shared<lazy_t>(cpp_forward(args)...))
+        {
+        }
+
+        async_lazy(const async_lazy&) = delete;
+        async_lazy(async_lazy&&) = delete;
+        async_lazy& operator=(const async_lazy&) = delete;
+        async_lazy& operator=(async_lazy&&) = delete;
+        ~async_lazy() = default;
+
+        template<std::invocable<task> Executor>
+        bool start(Executor&& executor)
+        {
+            if(started_.test_and_set(std::memory_order_relaxed)) return false;
+            invoke(cpp_forward(executor), task{lazy_});
+            return true;
+        }
+
+        bool start()
+        {
+            return start([this](task t) { worker_ = std::jthread{cpp_move(t)}; });
+        }
+
+        [[nodiscard]] bool started() const noexcept
+        {
+            return started_.test(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool has_value() const noexcept { return lazy_->has_value(); }
+
+        value_type& get() { return lazy_->get(); }
+
+        [[nodiscard]] const value_type& cget() const noexcept
+        {
+            return std::as_const(*lazy_).cget();
+        }
+    };
+
+    template<typename Fn>
+    async_lazy(Fn&&) -> async_lazy<std::decay_t<Fn>>;
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../memory/aligned.h"
+#include "bitset.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+
+namespace stdsharp::details
+{
+    template<bool Padded>
+    struct alignas(Padded ? cache_line_size : alignof(std::atomic<u64>)) atomic_bitset_word
+    {
+        std::atomic<u64> value{0};
+    };
+}
+
+namespace stdsharp
+{
+    // fixed size bitset of atomic 64-bit words, every operation is lock-free. with Padded each word
+    // lives in its own cache line so that threads working on different words never false share.
+    // multi-word reads like count() or iteration see each word atomically but not the whole set.
+    template<std::size_t N, bool Padded = false>
+    class atomic_bitset
+    {
+    public:
+        using size_type = std::size_t;
+        using word_type = u64;
+
+        static constexpr size_type word_size = details::bitset_word_size;
+        static constexpr size_type word_count = details::bitset_word_count<N>;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        std::array<details::atomic_bitset_word<Padded>, word_count> words_{};
+
+        [[nodiscard]] static constexpr word_type mask(const size_type index) noexcept
+        {
+            return word_type{1} << (index % word_size);
+        }
+
+        // valid bits of the word at index
+        [[nodiscard]] static constexpr word_type word_mask(const size_type index) noexcept
+        {
+            const auto bits = N - index * word_size;
+            return bits >= word_size ? ~word_type{0} : (word_type{1} << bits) - 1;
+        }
+
+        [[nodiscard]] constexpr auto& at(const size_type index) noexcept
+        {
+            return words_[index / word_size].value;
+        }
+
+        [[nodiscard]] constexpr const auto& at(const size_type index) const noexcept
+        {
+            return words_[index / word_size].value;
+        }
+
+    public:
+        atomic_bitset() = default;
+        atomic_bitset(const atomic_bitset&) = delete;
+        atomic_bitset(atomic_bitset&&) = delete;
+        atomic_bitset& operator=(const atomic_bitset&) = delete;
+        atomic_bitset& operator=(atomic_bitset&&) = delete;
+        ~atomic_bitset() = default;
+
+        [[nodiscard]] static constexpr size_type size() noexcept { return N; }
+
+        [[nodiscard]] word_type
+            word(const size_type index, const std::memory_order order = std::memory_order_seq_cst)
+                const noexcept
+        {
+            Expects(index < word_count);
+            return words_[index].value.load(order);
+        }
+
+        [[nodiscard]] bool
+            test(const size_type index, const std::memory_order order = std::memory_order_seq_cst)
+                const noexcept
+        {
+            Expects(index < N);
+            return (at(index).load(order) & mask(index)) != 0;
+        }
+
+        [[nodiscard]] bool operator[](const size_type index) const noexcept { return test(index); }
+
+        // returns the previous value of the bit, false means this call set it
+        bool try_set(
+            const size_type index,
+            const std::memory_order order = std::memory_order_seq_cst
+        ) noexcept
+        {
+            Expects(index < N);
+            return (at(index).fetch_or(mask(index), order) & mask(index)) != 0;
+        }
+
+        // returns the previous value of the bit, true means this call reset it
+        bool try_reset(
+            const size_type index,
+            const std::memory_order order = std::memory_order_seq_cst
+        ) noexcept
+        {
+            Expects(index < N);
+            return (at(index).fetch_and(~mask(index), order) & mask(index)) != 0;
+        }
+
+        void set(const size_type index, const std::memory_order order = std::memory_order_seq_cst)
+            noexcept
+        {
+            Expects(index < N);
+            at(index).fetch_or(mask(index), order);
+        }
+
+        void reset(const size_type index, const std::memory_order order = std::memory_order_seq_cst)
+            noexcept
+        {
+            Expects(index < N);
+            at(index).fetch_and(~mask(index), order);
+        }
+
+        void flip(const size_type index, const std::memory_order order = std::memory_order_seq_cst)
+            noexcept
+        {
+            Expects(index < N);
+            at(index).fetch_xor(mask(index), order);
+        }
+
+        // word-wise operations return the previous word, bits past N in bits are ignored
+        word_type fetch_or(
+            const size_type index,
+            const word_type bits,
+            const std::memory_order order = std::memory_order_seq_cst
+        ) noexcept
+        {
+            Expects(index < word_count);
+            return words_[index].value.fetch_or(bits & word_mask(index), order);
+        }
+
+        word_type fetch_and(
+            const size_type index,
+            const word_type bits,
+            const std::memory_order order = std::memory_order_seq_cst
+        ) noexcept
+        {
+            Expects(index < word_count);
+            return words_[index].value.fetch_and(bits, order);
+        }
+
+        word_type fetch_xor(
+            const size_type index,
+            const word_type bits,
+            const std::memory_order order = std::memory_order_seq_cst
+        ) noexcept
+        {
+            Expects(index < word_count);
+            return words_[index].value.fetch_xor(bits & word_mask(index), order);
+        }
+
+        // atomically sets the first unset bit at or after first and returns its index, npos if
+        // all are set. each bit is claimed by exactly one caller until it is reset.
+        size_type claim_first_unset(
+            const size_type first = 0,
+            const std::memory_order order = std::memory_order_seq_cst
+        ) noexcept
+        {
+            for(auto index = first / word_size; index < word_count; ++index)
+            {
+                auto& word = words_[index].value;
+                const auto valid = word_mask(index) &
+                    (index == first / word_size ? ~word_type{0} << (first % word_size) :
+                                                  ~word_type{0});
+                auto current = word.load(std::memory_order_relaxed);
+
+                for(auto unset = ~current & valid; unset != 0; unset = ~current & valid)
+                {
+                    const auto bit = word_type{1} << std::countr_zero(unset);
+                    current = word.fetch_or(bit, order);
+
+                    if((current & bit) == 0)
+                        return index * word_size + static_cast<size_type>(std::countr_zero(bit));
+
+                    current |= bit;
+                }
+            }
+
+            return npos;
+        }
+
+        void set_all(const std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i) words_[i].value.store(word_mask(i), order);
+        }
+
+        void reset_all(const std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            for(auto& word : words_) word.value.store(0, order);
+        }
+
+        [[nodiscard]] size_type count(const std::memory_order order = std::memory_order_seq_cst)
+            const noexcept
+        {
+            size_type count = 0;
+            for(const auto& word : words_) count += std::popcount(word.value.load(order));
+            return count;
+        }
+
+        [[nodiscard]] bool any(const std::memory_order order = std::memory_order_seq_cst)
+            const noexcept
+        {
+            return std::ranges::any_of(
+                words_,
+                [order](const auto& word) { return word.value.load(order) != 0; }
+            );
+        }
+
+        [[nodiscard]] bool none(const std::memory_order order = std::memory_order_seq_cst)
+            const noexcept
+        {
+            return !any(order);
+        }
+
+        [[nodiscard]] bool all(const std::memory_order order = std::memory_order_seq_cst)
+            const noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i)
+                if(words_[i].value.load(order) != word_mask(i)) return false;
+            return true;
+        }
+
+        [[nodiscard]] auto begin() const noexcept { return word_bitset_const_iterator{*this, 0}; }
+
+        [[nodiscard]] auto end() const noexcept { return word_bitset_const_iterator{*this, N}; }
+    };
+}
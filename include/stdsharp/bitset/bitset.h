@@ -4,18 +4,49 @@
 #include "../cstdint/cstdint.h"
 #include "../iterator/basic_iterator.h"
 
+#include <bit>
 #include <bitset>
+#include <cstring>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 #include "../compilation_config_in.h"
 
+namespace stdsharp
+{
+    // any std::bitset<N>
+    template<typename T>
+    concept std_bitset = requires(const T& set) {
+        []<std::size_t N>(const std::bitset<N>&) {}(set);
+    };
+
+    // runtime sized bitset exposing its storage as 64-bit words, bits past size() are always 0
+    template<typename T>
+    concept word_bitset = requires(T& t, const T& const_t, const std::size_t i) {
+        { const_t.size() } -> std::same_as<std::size_t>;
+        { const_t.words() } -> std::same_as<std::span<const u64>>;
+        { const_t[i] } -> std::same_as<bool>;
+        t[i];
+    };
+
+    // bitset read one 64-bit word at a time, e.g. from atomics, bits past size() are always 0
+    template<typename T>
+    concept word_readable_bitset = requires(const T& t, const std::size_t i) {
+        { t.size() } -> std::same_as<std::size_t>;
+        { t.word(i) } -> std::same_as<u64>;
+        { t[i] } -> std::same_as<bool>;
+    };
+}
+
 namespace stdsharp::details
 {
-    template<std::size_t N, bool IsConst>
+    template<typename Bitset, bool IsConst>
     class bitset_iterator
     {
     public:
-        using bitset = std::bitset<N>;
+        using bitset = Bitset;
 
     protected:
         using maybe_const = std::conditional_t<IsConst, const bitset, bitset>;
@@ -77,28 +108,129 @@ namespace stdsharp::details
         }
     };
 
+    inline constexpr std::size_t bitset_word_size = sizeof(u64) * char_bit;
+
+    template<std::size_t N>
+    inline constexpr std::size_t bitset_word_count = (N + bitset_word_size - 1) / bitset_word_size;
+
+    // all major implementations store std::bitset as an array of unsigned words with bit i at
+    // position i % word size of word i / word size, so on little endian targets the object
+    // representation can be read 64 bits at a time regardless of the actual word type
+    template<std::size_t N>
+    inline constexpr bool bitset_readable_as_bytes = std::endian::native == std::endian::little &&
+        std::is_trivially_copyable_v<std::bitset<N>> && sizeof(std::bitset<N>) * char_bit >= N;
+
+    // bits [index * 64, index * 64 + 64) of the set, inverted if Value is false. bits past N are 0
+    template<bool Value, std::size_t N>
+    [[nodiscard]] constexpr u64 bitset_word(const std::bitset<N>& set, const std::size_t index)
+    {
+        const auto first = index * bitset_word_size;
+        const auto bits = std::min(N - first, bitset_word_size);
+        const auto mask = bits == bitset_word_size ? ~u64{0} : (u64{1} << bits) - 1;
+        u64 word = 0;
+
+        if constexpr(bitset_readable_as_bytes<N>)
+        {
+            if(!std::is_constant_evaluated())
+            {
+                const auto offset = index * sizeof(u64);
+
+                std::memcpy(
+                    &word,
+                    reinterpret_cast<const std::byte*>(&set) + offset, // NOLINT
+                    std::min(sizeof(u64), sizeof(std::bitset<N>) - offset)
+                );
+
+                return (Value ? word : ~word) & mask;
+            }
+        }
+
+        for(std::size_t i = 0; i < bits; ++i) word |= static_cast<u64>(set[first + i]) << i;
+
+        return (Value ? word : ~word) & mask;
+    }
+
+    template<bool Value, typename Bitset>
+        requires word_bitset<Bitset> || word_readable_bitset<Bitset>
+    [[nodiscard]] constexpr u64 bitset_word(const Bitset& set, const std::size_t index)
+    {
+        const auto word = [&]
+        {
+            if constexpr(word_bitset<Bitset>) return set.words()[index];
+            else return set.word(index);
+        }();
+
+        if constexpr(Value) return word;
+        else
+        {
+            const auto bits = std::min(set.size() - index * bitset_word_size, bitset_word_size);
+            return ~word & (bits == bitset_word_size ? ~u64{0} : (u64{1} << bits) - 1);
+        }
+    }
+
+    // little endian serialization shared by the bitset based containers
+    template<std::unsigned_integral T>
+    constexpr void bitset_write(std::vector<std::byte>& bytes, const T value)
+    {
+        for(std::size_t i = 0; i < sizeof(T); ++i)
+            bytes.push_back(static_cast<std::byte>(value >> (i * char_bit)));
+    }
+
+    // consumes sizeof(T) bytes, throws std::invalid_argument if there are not enough
+    template<std::unsigned_integral T>
+    constexpr T bitset_read(std::span<const std::byte>& bytes)
+    {
+        if(bytes.size() < sizeof(T)) throw std::invalid_argument{"truncated serialized bitset"};
+
+        T value = 0;
+        for(std::size_t i = 0; i < sizeof(T); ++i)
+            value |= static_cast<T>(static_cast<T>(bytes[i]) << (i * char_bit));
+
+        bytes = bytes.subspan(sizeof(T));
+        return value;
+    }
 }
 
 namespace stdsharp
 {
     template<std::size_t N>
-    struct bitset_iterator : basic_iterator<details::bitset_iterator<N, false>>
+    struct bitset_iterator : basic_iterator<details::bitset_iterator<std::bitset<N>, false>>
     {
-        using basic_iterator<details::bitset_iterator<N, false>>::basic_iterator;
+        using basic_iterator<details::bitset_iterator<std::bitset<N>, false>>::basic_iterator;
     };
 
     template<std::size_t N>
     bitset_iterator(std::bitset<N>&, auto) -> bitset_iterator<N>;
 
     template<std::size_t N>
-    struct bitset_const_iterator : basic_iterator<details::bitset_iterator<N, true>>
+    struct bitset_const_iterator : basic_iterator<details::bitset_iterator<std::bitset<N>, true>>
     {
-        using basic_iterator<details::bitset_iterator<N, true>>::basic_iterator;
+        using basic_iterator<details::bitset_iterator<std::bitset<N>, true>>::basic_iterator;
     };
 
     template<std::size_t N>
     bitset_const_iterator(const std::bitset<N>&, auto) -> bitset_const_iterator<N>;
 
+    template<word_bitset Bitset>
+    struct word_bitset_iterator : basic_iterator<details::bitset_iterator<Bitset, false>>
+    {
+        using basic_iterator<details::bitset_iterator<Bitset, false>>::basic_iterator;
+    };
+
+    template<word_bitset Bitset>
+    word_bitset_iterator(Bitset&, auto) -> word_bitset_iterator<Bitset>;
+
+    template<typename Bitset>
+        requires word_bitset<Bitset> || word_readable_bitset<Bitset>
+    struct word_bitset_const_iterator : basic_iterator<details::bitset_iterator<Bitset, true>>
+    {
+        using basic_iterator<details::bitset_iterator<Bitset, true>>::basic_iterator;
+    };
+
+    template<typename Bitset>
+        requires word_bitset<Bitset> || word_readable_bitset<Bitset>
+    word_bitset_const_iterator(const Bitset&, auto) -> word_bitset_const_iterator<Bitset>;
+
     inline constexpr struct bitset_crng_fn
     {
         template<std::size_t N>
@@ -107,6 +239,16 @@ namespace stdsharp
             return std::ranges::
                 subrange{bitset_const_iterator{set, 0}, bitset_const_iterator{set, N}};
         }
+
+        template<typename Bitset>
+            requires word_bitset<Bitset> || word_readable_bitset<Bitset>
+        [[nodiscard]] constexpr auto operator()(const Bitset& set) const
+        {
+            return std::ranges::subrange{
+                word_bitset_const_iterator{set, 0},
+                word_bitset_const_iterator{set, set.size()}
+            };
+        }
     } bitset_crng{};
 
     inline constexpr struct bitset_rng_fn : bitset_crng_fn
@@ -118,7 +260,108 @@ namespace stdsharp
         {
             return std::ranges::subrange{bitset_iterator{set, 0}, bitset_iterator{set, N}};
         }
+
+        template<word_bitset Bitset>
+        [[nodiscard]] constexpr auto operator()(Bitset& set) const
+        {
+            return std::ranges::subrange{
+                word_bitset_iterator{set, 0},
+                word_bitset_iterator{set, set.size()}
+            };
+        }
     } bitset_rng{};
+
+    // visits indices of bits equal to Value in ascending order, skipping a whole word of the other
+    // value at a time. Bitset is std::bitset, a word_bitset or a word_readable_bitset
+    template<typename Bitset, bool Value = true>
+    class bitset_bit_iterator
+    {
+        const Bitset* set_ = nullptr;
+        std::size_t word_count_ = 0;
+        std::size_t word_index_ = 0;
+        u64 word_ = 0;
+
+        constexpr void seek()
+        {
+            while(word_ == 0 && ++word_index_ < word_count_)
+                word_ = details::bitset_word<Value>(*set_, word_index_);
+        }
+
+    public:
+        using value_type = std::size_t;
+        using difference_type = ssize_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        bitset_bit_iterator() = default;
+
+        // starts from the first matching bit at or after index first
+        explicit constexpr bitset_bit_iterator(const Bitset& set, const std::size_t first = 0):
+            set_(&set),
+            word_count_(
+                (static_cast<std::size_t>(set.size()) + details::bitset_word_size - 1) /
+                details::bitset_word_size
+            ),
+            word_index_(word_count_)
+        {
+            if(first >= set.size()) return;
+
+            word_index_ = first / details::bitset_word_size;
+            word_ = details::bitset_word<Value>(set, word_index_) &
+                (~u64{0} << (first % details::bitset_word_size));
+            seek();
+        }
+
+        [[nodiscard]] constexpr std::size_t operator*() const noexcept
+        {
+            Expects(word_ != 0);
+            return word_index_ * details::bitset_word_size +
+                static_cast<std::size_t>(std::countr_zero(word_));
+        }
+
+        constexpr bitset_bit_iterator& operator++()
+        {
+            word_ &= word_ - 1;
+            seek();
+            return *this;
+        }
+
+        constexpr bitset_bit_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const bitset_bit_iterator& other) const noexcept
+        {
+            return word_index_ == other.word_index_ && word_ == other.word_;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const std::default_sentinel_t /*unused*/
+        ) const noexcept
+        {
+            return word_index_ >= word_count_;
+        }
+    };
+
+    template<bool Value>
+    struct bitset_bits_fn
+    {
+        template<typename Bitset>
+            requires word_bitset<Bitset> || word_readable_bitset<Bitset> || std_bitset<Bitset>
+        [[nodiscard]] constexpr auto
+            operator()(const Bitset& set, const std::size_t first = 0) const
+        {
+            return std::ranges::subrange{
+                bitset_bit_iterator<Bitset, Value>{set, first},
+                std::default_sentinel
+            };
+        }
+    };
+
+    inline constexpr bitset_bits_fn<true> bitset_set_bits{};
+
+    inline constexpr bitset_bits_fn<false> bitset_unset_bits{};
 }
 
 #include "../compilation_config_out.h"
\ No newline at end of file
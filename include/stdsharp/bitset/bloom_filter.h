@@ -0,0 +1,321 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "dynamic_bitset.h"
+
+#include <array>
+#include <functional>
+#include <iterator>
+
+#include "../compilation_config_in.h"
+
+namespace stdsharp::details
+{
+    // murmur3 finalizer, spreads weak hashes like the identity std::hash of integers
+    [[nodiscard]] constexpr u64 bloom_mix(u64 hash) noexcept
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    inline constexpr std::size_t bloom_batch_size = 16;
+
+    // hashes up to bloom_batch_size keys, then tests them, so that the memory accesses of a batch
+    // are independent of each other
+    template<typename Filter, std::input_iterator I, typename Out>
+    constexpr Out bloom_contains_n(const Filter& filter, I first, std::size_t n, Out out)
+    {
+        std::array<u64, bloom_batch_size> hashes{};
+
+        while(n > 0)
+        {
+            const auto count = std::min(n, bloom_batch_size);
+
+            for(std::size_t i = 0; i < count; ++i, ++first) hashes[i] = filter.hash_of(*first);
+            for(std::size_t i = 0; i < count; ++i, ++out) *out = filter.contains_hash(hashes[i]);
+
+            n -= count;
+        }
+
+        return out;
+    }
+}
+
+namespace stdsharp
+{
+    // classic bloom filter over a dynamic_bitset, hash_count probes per key derived from one hash
+    // by double hashing. no false negatives, false positive rate about (1 - e^(-kn/m))^k.
+    template<
+        typename Key,
+        typename Hash = std::hash<Key>,
+        allocator_req Allocator = std::allocator<u64>>
+    class bloom_filter
+    {
+        template<typename Filter, std::input_iterator I, typename Out>
+        friend constexpr Out details::bloom_contains_n(const Filter&, I, std::size_t, Out);
+
+    public:
+        using key_type = Key;
+        using hasher = Hash;
+        using bitset = dynamic_bitset<Allocator>;
+        using allocator_type = bitset::allocator_type;
+        using size_type = std::size_t;
+
+    private:
+        bitset bits_;
+        size_type hash_count_;
+        STDSHARP_NO_UNIQUE_ADDRESS Hash hash_;
+
+        [[nodiscard]] u64 hash_of(const Key& key) const
+        {
+            return details::bloom_mix(static_cast<u64>(invoke(hash_, key)));
+        }
+
+        template<typename Fn>
+        void for_each_probe(const u64 hash, Fn fn) const
+        {
+            const auto step = std::rotl(hash, 32) | 1;
+            const auto size = bits_.size();
+
+            for(size_type i = 0; i < hash_count_; ++i)
+                if(!invoke(fn, static_cast<size_type>((hash + i * step) % size))) return;
+        }
+
+        [[nodiscard]] bool contains_hash(const u64 hash) const
+        {
+            bool found = true;
+
+            for_each_probe(
+                hash,
+                [this, &found](const size_type index) { return found = bits_[index]; }
+            );
+
+            return found;
+        }
+
+    public:
+        explicit bloom_filter(
+            const size_type bit_count,
+            const size_type hash_count,
+            const Hash& hash = Hash{},
+            const allocator_type& alloc = allocator_type{}
+        ):
+            bits_(bit_count, false, alloc), hash_count_(hash_count), hash_(hash)
+        {
+            Expects(bit_count > 0);
+            Expects(hash_count > 0);
+        }
+
+        [[nodiscard]] size_type bit_count() const noexcept { return bits_.size(); }
+
+        [[nodiscard]] size_type hash_count() const noexcept { return hash_count_; }
+
+        [[nodiscard]] const bitset& bits() const noexcept { return bits_; }
+
+        [[nodiscard]] hasher hash_function() const { return hash_; }
+
+        void insert(const Key& key)
+        {
+            for_each_probe(
+                hash_of(key),
+                [this](const size_type index)
+                {
+                    bits_.set(index);
+                    return true;
+                }
+            );
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const { return contains_hash(hash_of(key)); }
+
+        // writes contains(key) of n keys from first to out
+        template<std::input_iterator I, std::weakly_incrementable Out>
+        Out contains_n(I first, const size_type n, Out out) const
+        {
+            return details::bloom_contains_n(*this, cpp_move(first), n, cpp_move(out));
+        }
+
+        void clear() noexcept { bits_.reset(); }
+
+        // little endian: u64 bit count, u64 hash count and the words of the bitset
+        [[nodiscard]] std::vector<std::byte> serialize() const
+        {
+            std::vector<std::byte> bytes;
+
+            details::bitset_write(bytes, static_cast<u64>(bits_.size()));
+            details::bitset_write(bytes, static_cast<u64>(hash_count_));
+            for(const auto word : bits_.words()) details::bitset_write(bytes, word);
+
+            return bytes;
+        }
+
+        // throws std::invalid_argument on malformed input
+        [[nodiscard]] static bloom_filter deserialize(
+            std::span<const std::byte> bytes,
+            const Hash& hash = Hash{},
+            const allocator_type& alloc = allocator_type{}
+        )
+        {
+            const auto bit_count = details::bitset_read<u64>(bytes);
+            const auto hash_count = details::bitset_read<u64>(bytes);
+
+            if(bit_count == 0 || bit_count > bitset::max_size() || hash_count == 0)
+                throw std::invalid_argument{"invalid serialized bloom filter"};
+
+            if(const auto word_count = (bit_count + bitset::word_size - 1) / bitset::word_size;
+               bytes.size() != word_count * sizeof(u64))
+                throw std::invalid_argument{"invalid serialized bloom filter"};
+
+            bloom_filter filter{bit_count, hash_count, hash, alloc};
+
+            for(auto& word : filter.bits_.words()) word = details::bitset_read<u64>(bytes);
+
+            if(const auto bits = bit_count % bitset::word_size;
+               bits != 0 && (filter.bits_.words().back() >> bits) != 0)
+                throw std::invalid_argument{"invalid serialized bloom filter"};
+
+            return filter;
+        }
+    };
+
+    // split block bloom filter: a key maps to one cache line sized block and sets one bit in each
+    // of its 8 words, so a lookup touches a single cache line and the 8 word tests are independent
+    // of each other and vectorize. needs somewhat more bits than bloom_filter for the same rate.
+    template<
+        typename Key,
+        typename Hash = std::hash<Key>,
+        allocator_req Allocator = std::allocator<u64>>
+    class blocked_bloom_filter
+    {
+        template<typename Filter, std::input_iterator I, typename Out>
+        friend constexpr Out details::bloom_contains_n(const Filter&, I, std::size_t, Out);
+
+    public:
+        using key_type = Key;
+        using hasher = Hash;
+        using bitset = dynamic_bitset<Allocator>;
+        using allocator_type = bitset::allocator_type;
+        using size_type = std::size_t;
+
+        static constexpr size_type block_words = cache_line_size / sizeof(u64);
+        static constexpr size_type block_bits = block_words * bitset::word_size;
+
+    private:
+        // odd multipliers picking one bit per word from the low 32 bits of the hash
+        static constexpr std::array<u32, block_words> salts{
+            0x47b6137bU,
+            0x44974d91U,
+            0x8824ad5bU,
+            0xa2b7289dU,
+            0x705495c7U,
+            0x2df1424bU,
+            0x9efc4947U,
+            0x5c6bfb31U
+        };
+
+        bitset bits_;
+        STDSHARP_NO_UNIQUE_ADDRESS Hash hash_;
+
+        [[nodiscard]] u64 hash_of(const Key& key) const
+        {
+            return details::bloom_mix(static_cast<u64>(invoke(hash_, key)));
+        }
+
+        [[nodiscard]] size_type block_of(const u64 hash) const noexcept
+        {
+            return static_cast<size_type>(((hash >> 32) * (bits_.size() / block_bits)) >> 32);
+        }
+
+        [[nodiscard]] static constexpr u64 mask_of(const u64 hash, const size_type i) noexcept
+        {
+            return u64{1} << ((static_cast<u32>(hash) * salts[i]) >> 26);
+        }
+
+        [[nodiscard]] bool contains_hash(const u64 hash) const noexcept
+        {
+            const auto* const block = bits_.words().data() + block_of(hash) * block_words;
+            u64 missing = 0;
+
+            for(size_type i = 0; i < block_words; ++i)
+                missing |= mask_of(hash, i) & ~block[i]; // NOLINT(*-pointer-arithmetic)
+
+            return missing == 0;
+        }
+
+    public:
+        // bit_count is rounded up to a multiple of block_bits
+        explicit blocked_bloom_filter(
+            const size_type bit_count,
+            const Hash& hash = Hash{},
+            const allocator_type& alloc = allocator_type{}
+        ):
+            bits_((bit_count + block_bits - 1) / block_bits * block_bits, false, alloc), hash_(hash)
+        {
+            Expects(bit_count > 0);
+            Expects(bits_.size() / block_bits <= (size_type{1} << 32));
+        }
+
+        [[nodiscard]] size_type bit_count() const noexcept { return bits_.size(); }
+
+        [[nodiscard]] const bitset& bits() const noexcept { return bits_; }
+
+        [[nodiscard]] hasher hash_function() const { return hash_; }
+
+        void insert(const Key& key)
+        {
+            const auto hash = hash_of(key);
+            auto* const block = bits_.words().data() + block_of(hash) * block_words;
+
+            for(size_type i = 0; i < block_words; ++i)
+                block[i] |= mask_of(hash, i); // NOLINT(*-pointer-arithmetic)
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const { return contains_hash(hash_of(key)); }
+
+        // writes contains(key) of n keys from first to out
+        template<std::input_iterator I, std::weakly_incrementable Out>
+        Out contains_n(I first, const size_type n, Out out) const
+        {
+            return details::bloom_contains_n(*this, cpp_move(first), n, cpp_move(out));
+        }
+
+        void clear() noexcept { bits_.reset(); }
+
+        // little endian: u64 bit count and the words of the bitset
+        [[nodiscard]] std::vector<std::byte> serialize() const
+        {
+            std::vector<std::byte> bytes;
+
+            details::bitset_write(bytes, static_cast<u64>(bits_.size()));
+            for(const auto word : bits_.words()) details::bitset_write(bytes, word);
+
+            return bytes;
+        }
+
+        // throws std::invalid_argument on malformed input
+        [[nodiscard]] static blocked_bloom_filter deserialize(
+            std::span<const std::byte> bytes,
+            const Hash& hash = Hash{},
+            const allocator_type& alloc = allocator_type{}
+        )
+        {
+            const auto bit_count = details::bitset_read<u64>(bytes);
+
+            if(bit_count == 0 || bit_count > bitset::max_size() || bit_count % block_bits != 0 ||
+               bytes.size() != bit_count / bitset::word_size * sizeof(u64))
+                throw std::invalid_argument{"invalid serialized blocked bloom filter"};
+
+            blocked_bloom_filter filter{bit_count, hash, alloc};
+
+            for(auto& word : filter.bits_.words()) word = details::bitset_read<u64>(bytes);
+
+            return filter;
+        }
+    };
+}
+
+#include "../compilation_config_out.h"
@@ -0,0 +1,558 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../memory/aligned.h"
+#include "../memory/allocator_traits.h"
+#include "bitset.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <span>
+#include <utility>
+
+#include "../compilation_config_in.h"
+
+namespace stdsharp
+{
+    // runtime sized bitset stored in cache line aligned blocks of 64-bit words. word-wise
+    // operations are plain loops over contiguous aligned words so that the compiler vectorizes
+    // them. bits past size() are kept 0.
+    template<allocator_req Allocator = std::allocator<u64>>
+    class dynamic_bitset
+    {
+    public:
+        using size_type = std::size_t;
+        using word_type = u64;
+
+        static constexpr size_type word_size = details::bitset_word_size;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        struct alignas(cache_line_size) block
+        {
+            word_type words[cache_line_size / sizeof(word_type)]; // NOLINT(*-c-arrays)
+        };
+
+        using allocator_type = allocator_traits<Allocator>::template rebind_alloc<block>;
+
+        class reference
+        {
+            friend class dynamic_bitset;
+
+            word_type* word_;
+            word_type mask_;
+
+            constexpr reference(word_type& word, const size_type index) noexcept:
+                word_(&word), mask_(word_type{1} << index)
+            {
+            }
+
+        public:
+            reference(const reference&) = default;
+            reference(reference&&) = default;
+            ~reference() = default;
+
+            constexpr reference& operator=(const bool value) noexcept
+            {
+                if(value) *word_ |= mask_;
+                else *word_ &= ~mask_;
+                return *this;
+            }
+
+            constexpr reference& operator=(const reference& other) noexcept
+            {
+                return *this = static_cast<bool>(other);
+            }
+
+            constexpr reference& operator=(reference&& other) noexcept
+            {
+                return *this = static_cast<bool>(other);
+            }
+
+            [[nodiscard]] constexpr operator bool() const noexcept // NOLINT(*-explicit-*)
+            {
+                return (*word_ & mask_) != 0;
+            }
+
+            [[nodiscard]] constexpr bool operator~() const noexcept { return !*this; }
+
+            constexpr reference& flip() noexcept
+            {
+                *word_ ^= mask_;
+                return *this;
+            }
+        };
+
+    private:
+        using alloc_traits = allocator_traits<allocator_type>;
+
+        static constexpr size_type words_per_block = cache_line_size / sizeof(word_type);
+
+        STDSHARP_NO_UNIQUE_ADDRESS allocator_type alloc_{};
+        alloc_traits::pointer blocks_ = nullptr;
+        size_type block_count_ = 0;
+        size_type size_ = 0;
+
+        [[nodiscard]] static constexpr size_type to_word_count(const size_type bits) noexcept
+        {
+            return (bits + word_size - 1) / word_size;
+        }
+
+        [[nodiscard]] word_type* data() noexcept
+        {
+            return blocks_ == nullptr ? nullptr : pointer_cast<word_type>(std::to_address(blocks_));
+        }
+
+        [[nodiscard]] const word_type* data() const noexcept
+        {
+            return blocks_ == nullptr ? nullptr : pointer_cast<word_type>(std::to_address(blocks_));
+        }
+
+        void clear_tail() noexcept
+        {
+            if(const auto bits = size_ % word_size; bits != 0)
+                data()[size_ / word_size] &= (word_type{1} << bits) - 1;
+        }
+
+        void deallocate() noexcept
+        {
+            if(blocks_ == nullptr) return;
+            alloc_traits::deallocate(alloc_, blocks_, block_count_);
+            blocks_ = nullptr;
+            block_count_ = 0;
+        }
+
+        void reallocate(const size_type block_count)
+        {
+            const auto blocks = alloc_traits::allocate(alloc_, block_count);
+            auto* const words = pointer_cast<word_type>(std::to_address(blocks));
+            const auto count = word_count();
+
+            std::ranges::copy_n(data(), static_cast<std::ptrdiff_t>(count), words);
+            std::ranges::fill_n(
+                words + count, // NOLINT(*-pointer-arithmetic)
+                static_cast<std::ptrdiff_t>(block_count * words_per_block - count),
+                word_type{0}
+            );
+
+            deallocate();
+            blocks_ = blocks;
+            block_count_ = block_count;
+        }
+
+        void set_range(size_type first, const size_type last) noexcept
+        {
+            auto* const words = data();
+
+            while(first < last)
+            {
+                const auto offset = first % word_size;
+                const auto bits = std::min(word_size - offset, last - first);
+                const auto mask = bits == word_size ? ~word_type{0} : (word_type{1} << bits) - 1;
+
+                words[first / word_size] |= mask << offset;
+                first += bits;
+            }
+        }
+
+        void assign_words(const dynamic_bitset& other)
+        {
+            size_ = 0;
+            reserve(other.size_);
+            size_ = other.size_;
+            std::ranges::copy(other.words(), data());
+        }
+
+        template<typename Op>
+        dynamic_bitset& apply(const dynamic_bitset& other, const Op op) noexcept
+        {
+            Expects(size_ == other.size_);
+
+            auto* const left = data();
+            const auto* const right = other.data();
+
+            for(size_type i = 0, count = word_count(); i < count; ++i)
+                left[i] = op(left[i], right[i]); // NOLINT(*-pointer-arithmetic)
+
+            return *this;
+        }
+
+        void steal(dynamic_bitset& other) noexcept
+        {
+            deallocate();
+            blocks_ = std::exchange(other.blocks_, nullptr);
+            block_count_ = std::exchange(other.block_count_, 0);
+            size_ = std::exchange(other.size_, 0);
+        }
+
+    public:
+        dynamic_bitset() = default;
+
+        explicit dynamic_bitset(const allocator_type& alloc) noexcept: alloc_(alloc) {}
+
+        explicit dynamic_bitset(
+            const size_type size,
+            const bool value = false,
+            const allocator_type& alloc = allocator_type{}
+        ):
+            alloc_(alloc)
+        {
+            resize(size, value);
+        }
+
+        template<std::size_t N>
+        explicit dynamic_bitset(
+            const std::bitset<N>& set,
+            const allocator_type& alloc = allocator_type{}
+        ):
+            dynamic_bitset(N, false, alloc)
+        {
+            auto* const words = data();
+            for(size_type i = 0, count = word_count(); i < count; ++i)
+                words[i] = details::bitset_word<true>(set, i); // NOLINT(*-pointer-arithmetic)
+        }
+
+        dynamic_bitset(const dynamic_bitset& other):
+            alloc_(alloc_traits::select_on_container_copy_construction(other.alloc_))
+        {
+            assign_words(other);
+        }
+
+        dynamic_bitset(const dynamic_bitset& other, const allocator_type& alloc): alloc_(alloc)
+        {
+            assign_words(other);
+        }
+
+        dynamic_bitset(dynamic_bitset&& other) noexcept: alloc_(cpp_move(other.alloc_))
+        {
+            steal(other);
+        }
+
+        dynamic_bitset& operator=(const dynamic_bitset& other)
+        {
+            if(this == &other) return *this;
+
+            if constexpr(alloc_traits::propagate_on_copy_v)
+            {
+                if(alloc_ != other.alloc_) deallocate();
+                alloc_ = other.alloc_;
+            }
+
+            assign_words(other);
+            return *this;
+        }
+
+        dynamic_bitset& operator=(dynamic_bitset&& other) noexcept(
+            alloc_traits::propagate_on_move_v || alloc_traits::always_equal_v
+        )
+        {
+            if(this == &other) return *this;
+
+            if constexpr(alloc_traits::propagate_on_move_v)
+            {
+                deallocate();
+                alloc_ = cpp_move(other.alloc_);
+                steal(other);
+            }
+            else if(alloc_ == other.alloc_) steal(other);
+            else assign_words(other);
+
+            return *this;
+        }
+
+        ~dynamic_bitset() { deallocate(); }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return alloc_; }
+
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        // largest size whose word count is representable
+        [[nodiscard]] static constexpr size_type max_size() noexcept
+        {
+            return std::numeric_limits<size_type>::max() / word_size * word_size;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept
+        {
+            return block_count_ * words_per_block * word_size;
+        }
+
+        [[nodiscard]] size_type word_count() const noexcept { return to_word_count(size_); }
+
+        [[nodiscard]] std::span<const word_type> words() const noexcept
+        {
+            return {data(), word_count()};
+        }
+
+        // bits past size() must be left 0
+        [[nodiscard]] std::span<word_type> words() noexcept { return {data(), word_count()}; }
+
+        void reserve(const size_type bits)
+        {
+            if(bits <= capacity()) return;
+            reallocate((to_word_count(bits) + words_per_block - 1) / words_per_block);
+        }
+
+        void resize(const size_type size, const bool value = false)
+        {
+            if(size > size_)
+            {
+                reserve(size);
+
+                const auto old_count = word_count();
+
+                std::ranges::fill_n(
+                    data() + old_count, // NOLINT(*-pointer-arithmetic)
+                    static_cast<std::ptrdiff_t>(to_word_count(size) - old_count),
+                    word_type{0}
+                );
+
+                if(value) set_range(size_, size);
+            }
+
+            size_ = size;
+            clear_tail();
+        }
+
+        void push_back(const bool value)
+        {
+            if(size_ == capacity()) reserve(std::max(size_ * 2, words_per_block * word_size));
+            if(size_ % word_size == 0) data()[size_ / word_size] = 0;
+
+            ++size_;
+            set(size_ - 1, value);
+        }
+
+        void clear() noexcept { size_ = 0; }
+
+        void shrink_to_fit()
+        {
+            if(size_ == 0) deallocate();
+            else if(const auto blocks = (word_count() + words_per_block - 1) / words_per_block;
+                    blocks < block_count_)
+                reallocate(blocks);
+        }
+
+        [[nodiscard]] bool test(const size_type index) const noexcept
+        {
+            Expects(index < size_);
+            return ((data()[index / word_size] >> (index % word_size)) & 1) != 0;
+        }
+
+        [[nodiscard]] bool operator[](const size_type index) const noexcept { return test(index); }
+
+        [[nodiscard]] reference operator[](const size_type index) noexcept
+        {
+            Expects(index < size_);
+            return {data()[index / word_size], index % word_size};
+        }
+
+        dynamic_bitset& set() noexcept
+        {
+            std::ranges::fill(std::span{data(), word_count()}, ~word_type{0});
+            clear_tail();
+            return *this;
+        }
+
+        dynamic_bitset& set(const size_type index, const bool value = true) noexcept
+        {
+            (*this)[index] = value;
+            return *this;
+        }
+
+        dynamic_bitset& reset() noexcept
+        {
+            std::ranges::fill(std::span{data(), word_count()}, word_type{0});
+            return *this;
+        }
+
+        dynamic_bitset& reset(const size_type index) noexcept { return set(index, false); }
+
+        dynamic_bitset& flip() noexcept
+        {
+            for(auto& word : std::span{data(), word_count()}) word = ~word;
+            clear_tail();
+            return *this;
+        }
+
+        dynamic_bitset& flip(const size_type index) noexcept
+        {
+            (*this)[index].flip();
+            return *this;
+        }
+
+        [[nodiscard]] size_type count() const noexcept
+        {
+            size_type count = 0;
+            for(const auto word : words()) count += std::popcount(word);
+            return count;
+        }
+
+        [[nodiscard]] bool any() const noexcept
+        {
+            return std::ranges::any_of(words(), [](const word_type word) { return word != 0; });
+        }
+
+        [[nodiscard]] bool none() const noexcept { return !any(); }
+
+        [[nodiscard]] bool all() const noexcept { return count() == size_; }
+
+        // index of the first set bit, npos if none
+        [[nodiscard]] size_type find_first() const noexcept
+        {
+            const auto it = bitset_set_bits(*this).begin();
+            return it == std::default_sentinel ? npos : *it;
+        }
+
+        // index of the first set bit after index, npos if none
+        [[nodiscard]] size_type find_next(const size_type index) const noexcept
+        {
+            if(index + 1 >= size_) return npos;
+
+            const auto it = bitset_set_bits(*this, index + 1).begin();
+            return it == std::default_sentinel ? npos : *it;
+        }
+
+        dynamic_bitset& operator&=(const dynamic_bitset& other) noexcept
+        {
+            return apply(other, [](const word_type l, const word_type r) { return l & r; });
+        }
+
+        dynamic_bitset& operator|=(const dynamic_bitset& other) noexcept
+        {
+            return apply(other, [](const word_type l, const word_type r) { return l | r; });
+        }
+
+        dynamic_bitset& operator^=(const dynamic_bitset& other) noexcept
+        {
+            return apply(other, [](const word_type l, const word_type r) { return l ^ r; });
+        }
+
+        // clears the bits set in other
+        dynamic_bitset& and_not(const dynamic_bitset& other) noexcept
+        {
+            return apply(other, [](const word_type l, const word_type r) { return l & ~r; });
+        }
+
+        dynamic_bitset& operator<<=(const size_type n) noexcept
+        {
+            if(n >= size_) return reset();
+
+            auto* const words = data();
+            const auto count = word_count();
+            const auto word_shift = n / word_size;
+            const auto bit_shift = n % word_size;
+
+            // NOLINTBEGIN(*-pointer-arithmetic)
+            if(bit_shift == 0)
+                for(auto i = count; i-- > word_shift;) words[i] = words[i - word_shift];
+            else
+            {
+                for(auto i = count - 1; i > word_shift; --i)
+                    words[i] = (words[i - word_shift] << bit_shift) |
+                        (words[i - word_shift - 1] >> (word_size - bit_shift));
+                words[word_shift] = words[0] << bit_shift;
+            }
+            // NOLINTEND(*-pointer-arithmetic)
+
+            std::ranges::fill_n(words, static_cast<std::ptrdiff_t>(word_shift), word_type{0});
+            clear_tail();
+            return *this;
+        }
+
+        dynamic_bitset& operator>>=(const size_type n) noexcept
+        {
+            if(n >= size_) return reset();
+
+            auto* const words = data();
+            const auto count = word_count();
+            const auto word_shift = n / word_size;
+            const auto bit_shift = n % word_size;
+            const auto last = count - word_shift;
+
+            // NOLINTBEGIN(*-pointer-arithmetic)
+            if(bit_shift == 0)
+                for(size_type i = 0; i < last; ++i) words[i] = words[i + word_shift];
+            else
+            {
+                for(size_type i = 0; i + 1 < last; ++i)
+                    words[i] = (words[i + word_shift] >> bit_shift) |
+                        (words[i + word_shift + 1] << (word_size - bit_shift));
+                words[last - 1] = words[count - 1] >> bit_shift;
+            }
+
+            std::ranges::
+                fill_n(words + last, static_cast<std::ptrdiff_t>(word_shift), word_type{0});
+            // NOLINTEND(*-pointer-arithmetic)
+
+            return *this;
+        }
+
+        [[nodiscard]] dynamic_bitset operator~() const
+        {
+            auto copy = *this;
+            copy.flip();
+            return copy;
+        }
+
+        [[nodiscard]] dynamic_bitset operator<<(const size_type n) const
+        {
+            auto copy = *this;
+            copy <<= n;
+            return copy;
+        }
+
+        [[nodiscard]] dynamic_bitset operator>>(const size_type n) const
+        {
+            auto copy = *this;
+            copy >>= n;
+            return copy;
+        }
+
+        [[nodiscard]] friend dynamic_bitset
+            operator&(dynamic_bitset left, const dynamic_bitset& right)
+        {
+            left &= right;
+            return left;
+        }
+
+        [[nodiscard]] friend dynamic_bitset
+            operator|(dynamic_bitset left, const dynamic_bitset& right)
+        {
+            left |= right;
+            return left;
+        }
+
+        [[nodiscard]] friend dynamic_bitset
+            operator^(dynamic_bitset left, const dynamic_bitset& right)
+        {
+            left ^= right;
+            return left;
+        }
+
+        [[nodiscard]] friend bool
+            operator==(const dynamic_bitset& left, const dynamic_bitset& right) noexcept
+        {
+            return left.size_ == right.size_ && std::ranges::equal(left.words(), right.words());
+        }
+
+        void swap(dynamic_bitset& other) noexcept
+        {
+            if constexpr(alloc_traits::propagate_on_swap_v) std::ranges::swap(alloc_, other.alloc_);
+            else Expects(alloc_ == other.alloc_);
+
+            std::ranges::swap(blocks_, other.blocks_);
+            std::ranges::swap(block_count_, other.block_count_);
+            std::ranges::swap(size_, other.size_);
+        }
+
+        friend void swap(dynamic_bitset& left, dynamic_bitset& right) noexcept
+        {
+            left.swap(right);
+        }
+    };
+}
+
+#include "../compilation_config_out.h"
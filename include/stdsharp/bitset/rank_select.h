@@ -0,0 +1,203 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "bitset.h"
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+namespace stdsharp::details
+{
+    // select within a word, k < popcount(word)
+    [[nodiscard]] constexpr std::size_t select_in_word(u64 word, std::size_t k) noexcept
+    {
+        std::size_t shift = 0;
+
+        for(;; shift += char_bit)
+        {
+            const auto count = static_cast<std::size_t>(std::popcount((word >> shift) & 0xff));
+            if(k < count) break;
+            k -= count;
+        }
+
+        word >>= shift;
+        for(; k > 0; --k) word &= word - 1;
+
+        return shift + static_cast<std::size_t>(std::countr_zero(word));
+    }
+}
+
+namespace stdsharp
+{
+    // poppy style rank and select directory over a bitset, which must outlive the directory and
+    // stay unmodified. every 2048-bit block keeps one 64-bit entry packing the count before the
+    // block in low 32 bits and the counts of its first three 512-bit sub-blocks in 10 bits each.
+    // counts before every 2^SuperBlockShift bits are stored separately and the block of every
+    // 8192nd set bit is sampled for select, about 3.5% space overhead in total. a super block spans
+    // at least one block and leaves the high 30 bits of an entry to the sub-block counts.
+    template<typename Bitset, std::size_t SuperBlockShift = 32>
+        requires(word_bitset<Bitset> || std_bitset<Bitset>) &&
+        (SuperBlockShift >= 11 && SuperBlockShift <= 34)
+    class rank_select
+    {
+        static constexpr std::size_t word_size = details::bitset_word_size;
+        static constexpr std::size_t block_bits = 2048;
+        static constexpr std::size_t sub_block_bits = 512;
+        static constexpr std::size_t sub_block_words = sub_block_bits / word_size;
+        static constexpr std::size_t sub_blocks = block_bits / sub_block_bits;
+        static constexpr std::size_t sub_count_bits = 10;
+        static constexpr std::size_t super_block_shift = SuperBlockShift;
+        static constexpr std::size_t select_sample_rate = 8192;
+        static constexpr u64 low_mask = (u64{1} << super_block_shift) - 1;
+
+        const Bitset* set_;
+        std::size_t size_;
+        std::size_t count_ = 0;
+        std::vector<u64> super_blocks_;
+        std::vector<u64> blocks_;
+        std::vector<std::size_t> samples_;
+
+        [[nodiscard]] u64 word(const std::size_t index) const
+        {
+            return details::bitset_word<true>(*set_, index);
+        }
+
+        [[nodiscard]] std::size_t word_count() const noexcept
+        {
+            return (size_ + word_size - 1) / word_size;
+        }
+
+        [[nodiscard]] std::size_t block_rank(const std::size_t block) const noexcept
+        {
+            return super_blocks_[(block * block_bits) >> super_block_shift] +
+                (blocks_[block] & low_mask);
+        }
+
+        [[nodiscard]] static std::size_t sub_block_count(const u64 entry, const std::size_t sub)
+        {
+            return (entry >> (super_block_shift + sub * sub_count_bits)) &
+                ((u64{1} << sub_count_bits) - 1);
+        }
+
+        [[nodiscard]] std::size_t popcount_words(std::size_t first, const std::size_t last) const
+        {
+            std::size_t count = 0;
+            for(; first < last; ++first) count += std::popcount(word(first));
+            return count;
+        }
+
+    public:
+        explicit rank_select(const Bitset& set):
+            set_(&set), size_(set.size()), blocks_(size_ / block_bits + 1)
+        {
+            const auto words = word_count();
+
+            super_blocks_.reserve((size_ >> super_block_shift) + 1);
+
+            for(std::size_t block = 0; block < blocks_.size(); ++block)
+            {
+                const auto first_word = block * block_bits / word_size;
+
+                if(((block * block_bits) & low_mask) == 0) super_blocks_.push_back(count_);
+
+                auto entry = static_cast<u64>(count_ - super_blocks_.back());
+
+                for(std::size_t sub = 0; sub < sub_blocks; ++sub)
+                {
+                    const auto begin = std::min(first_word + sub * sub_block_words, words);
+                    const auto count =
+                        popcount_words(begin, std::min(begin + sub_block_words, words));
+
+                    for(auto i = count_ == 0 ? 0 : (count_ - 1) / select_sample_rate + 1;
+                        i * select_sample_rate < count_ + count;
+                        ++i)
+                        if(i == samples_.size()) samples_.push_back(block);
+
+                    if(sub + 1 < sub_blocks)
+                        entry |= static_cast<u64>(count)
+                            << (super_block_shift + sub * sub_count_bits);
+
+                    count_ += count;
+                }
+
+                blocks_[block] = entry;
+            }
+
+            samples_.push_back(blocks_.size() - 1);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+        // number of set bits
+        [[nodiscard]] std::size_t count() const noexcept { return count_; }
+
+        // number of set bits in [0, index)
+        [[nodiscard]] std::size_t rank(const std::size_t index) const
+        {
+            Expects(index <= size_);
+
+            const auto block = index / block_bits;
+            const auto entry = blocks_[block];
+            const auto sub = index % block_bits / sub_block_bits;
+            const auto word_index = index / word_size;
+            auto rank = block_rank(block);
+
+            for(std::size_t i = 0; i < sub; ++i) rank += sub_block_count(entry, i);
+
+            rank += popcount_words(index / sub_block_bits * sub_block_words, word_index);
+
+            if(const auto bits = index % word_size; bits != 0)
+                rank += std::popcount(word(word_index) & ((u64{1} << bits) - 1));
+
+            return rank;
+        }
+
+        // number of unset bits in [0, index)
+        [[nodiscard]] std::size_t rank0(const std::size_t index) const
+        {
+            return index - rank(index);
+        }
+
+        // index of the k-th set bit, counting from 0
+        [[nodiscard]] std::size_t select(std::size_t k) const
+        {
+            Expects(k < count_);
+
+            const auto sample = k / select_sample_rate;
+
+            // last block whose rank is not greater than k
+            const auto block = *std::ranges::prev(std::ranges::upper_bound(
+                std::views::iota(samples_[sample], samples_[sample + 1] + 1),
+                k,
+                std::ranges::less{},
+                [this](const std::size_t b) { return block_rank(b); }
+            ));
+
+            const auto entry = blocks_[block];
+            k -= block_rank(block);
+
+            auto word_index = block * block_bits / word_size;
+
+            for(std::size_t sub = 0; sub + 1 < sub_blocks; ++sub, word_index += sub_block_words)
+            {
+                const auto count = sub_block_count(entry, sub);
+                if(k < count) break;
+                k -= count;
+            }
+
+            for(;; ++word_index)
+            {
+                const auto w = word(word_index);
+                const auto count = static_cast<std::size_t>(std::popcount(w));
+
+                if(k < count) return word_index * word_size + details::select_in_word(w, k);
+
+                k -= count;
+            }
+        }
+    };
+
+    template<typename Bitset>
+    rank_select(const Bitset&) -> rank_select<Bitset>;
+}
@@ -0,0 +1,798 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "bitset.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+namespace stdsharp::details
+{
+    inline constexpr std::size_t roaring_chunk_size = 1 << 16;
+    inline constexpr std::size_t roaring_bitmap_words = roaring_chunk_size / 64;
+
+    // array containers never hold more than this, bitmap containers never hold fewer
+    inline constexpr std::size_t roaring_array_max = 4096;
+
+    struct roaring_array_container
+    {
+        std::vector<u16> values;
+    };
+
+    struct roaring_bitmap_container
+    {
+        std::vector<u64> words = std::vector<u64>(roaring_bitmap_words);
+        std::size_t cardinality = 0;
+
+        constexpr bool set(const u16 value)
+        {
+            auto& word = words[value / 64];
+            const auto mask = u64{1} << (value % 64);
+            if((word & mask) != 0) return false;
+            word |= mask;
+            ++cardinality;
+            return true;
+        }
+
+        constexpr bool reset(const u16 value)
+        {
+            auto& word = words[value / 64];
+            const auto mask = u64{1} << (value % 64);
+            if((word & mask) == 0) return false;
+            word &= ~mask;
+            --cardinality;
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool test(const u16 value) const
+        {
+            return ((words[value / 64] >> (value % 64)) & 1) != 0;
+        }
+
+        // first set bit at or after value, roaring_chunk_size if none
+        [[nodiscard]] constexpr std::size_t next(const std::size_t value) const
+        {
+            if(value >= roaring_chunk_size) return roaring_chunk_size;
+
+            auto index = value / 64;
+            auto word = words[index] & (~u64{0} << (value % 64));
+
+            while(word == 0)
+            {
+                if(++index == roaring_bitmap_words) return roaring_chunk_size;
+                word = words[index];
+            }
+
+            return index * 64 + static_cast<std::size_t>(std::countr_zero(word));
+        }
+
+        constexpr void set_range(const std::size_t first, const std::size_t last)
+        {
+            for(auto i = first; i <= last; ++i) set(static_cast<u16>(i));
+        }
+    };
+
+    // run covering [start, start + length]
+    struct roaring_run
+    {
+        u16 start;
+        u16 length;
+    };
+
+    struct roaring_run_container
+    {
+        std::vector<roaring_run> runs;
+    };
+
+    using roaring_container =
+        std::variant<roaring_array_container, roaring_bitmap_container, roaring_run_container>;
+
+    template<typename... Fn>
+    struct roaring_visitor : Fn...
+    {
+        using Fn::operator()...;
+    };
+
+    [[nodiscard]] constexpr std::size_t roaring_cardinality(const roaring_container& container)
+    {
+        return std::visit(
+            roaring_visitor{
+                [](const roaring_array_container& c) { return c.values.size(); },
+                [](const roaring_bitmap_container& c) { return c.cardinality; },
+                [](const roaring_run_container& c)
+                {
+                    std::size_t count = 0;
+                    for(const auto run : c.runs) count += run.length + 1U;
+                    return count;
+                }
+            },
+            container
+        );
+    }
+
+    [[nodiscard]] constexpr bool
+        roaring_contains(const roaring_container& container, const u16 value)
+    {
+        return std::visit(
+            roaring_visitor{
+                [value](const roaring_array_container& c)
+                {
+                    return std::ranges::binary_search(c.values, value); //
+                },
+                [value](const roaring_bitmap_container& c) { return c.test(value); },
+                [value](const roaring_run_container& c)
+                {
+                    const auto it =
+                        std::ranges::upper_bound(c.runs, value, {}, &roaring_run::start);
+                    if(it == c.runs.begin()) return false;
+
+                    const auto run = *std::ranges::prev(it);
+                    return value <= run.start + std::size_t{run.length};
+                }
+            },
+            container
+        );
+    }
+
+    [[nodiscard]] constexpr roaring_bitmap_container
+        roaring_to_bitmap(const roaring_container& container)
+    {
+        return std::visit(
+            roaring_visitor{
+                [](const roaring_array_container& c)
+                {
+                    roaring_bitmap_container bitmap;
+                    for(const auto value : c.values) bitmap.set(value);
+                    return bitmap;
+                },
+                [](const roaring_bitmap_container& c) { return c; },
+                [](const roaring_run_container& c)
+                {
+                    roaring_bitmap_container bitmap;
+                    for(const auto run : c.runs)
+                        bitmap.set_range(run.start, run.start + std::size_t{run.length});
+                    return bitmap;
+                }
+            },
+            container
+        );
+    }
+
+    [[nodiscard]] constexpr roaring_array_container
+        roaring_to_array(const roaring_container& container)
+    {
+        return std::visit(
+            roaring_visitor{
+                [](const roaring_array_container& c) { return c; },
+                [](const roaring_bitmap_container& c)
+                {
+                    roaring_array_container array;
+                    array.values.reserve(c.cardinality);
+                    for(auto i = c.next(0); i < roaring_chunk_size; i = c.next(i + 1))
+                        array.values.push_back(static_cast<u16>(i));
+                    return array;
+                },
+                [](const roaring_run_container& c)
+                {
+                    roaring_array_container array;
+                    for(const auto run : c.runs)
+                    {
+                        const auto last = run.start + std::size_t{run.length};
+                        for(std::size_t i = run.start; i <= last; ++i)
+                            array.values.push_back(static_cast<u16>(i));
+                    }
+                    return array;
+                }
+            },
+            container
+        );
+    }
+
+    // array or bitmap container, whichever the cardinality calls for
+    [[nodiscard]] constexpr roaring_container roaring_normalize(roaring_container container)
+    {
+        const auto cardinality = roaring_cardinality(container);
+
+        if(cardinality <= roaring_array_max)
+        {
+            if(!std::holds_alternative<roaring_array_container>(container))
+                return roaring_to_array(container);
+        }
+        else if(!std::holds_alternative<roaring_bitmap_container>(container))
+            return roaring_to_bitmap(container);
+
+        return container;
+    }
+
+    [[nodiscard]] constexpr roaring_container
+        roaring_or(const roaring_container& left, const roaring_container& right)
+    {
+        const auto* const left_array = std::get_if<roaring_array_container>(&left);
+        const auto* const right_array = std::get_if<roaring_array_container>(&right);
+
+        if(left_array != nullptr && right_array != nullptr)
+        {
+            roaring_array_container result;
+            result.values.reserve(left_array->values.size() + right_array->values.size());
+            std::ranges::set_union(
+                left_array->values,
+                right_array->values,
+                std::back_inserter(result.values)
+            );
+            return roaring_normalize(cpp_move(result));
+        }
+
+        auto result = roaring_to_bitmap(left);
+
+        std::visit(
+            roaring_visitor{
+                [&result](const roaring_array_container& c)
+                {
+                    for(const auto value : c.values) result.set(value);
+                },
+                [&result](const roaring_bitmap_container& c)
+                {
+                    std::size_t cardinality = 0;
+                    for(std::size_t i = 0; i < roaring_bitmap_words; ++i)
+                    {
+                        result.words[i] |= c.words[i];
+                        cardinality += std::popcount(result.words[i]);
+                    }
+                    result.cardinality = cardinality;
+                },
+                [&result](const roaring_run_container& c)
+                {
+                    for(const auto run : c.runs)
+                        result.set_range(run.start, run.start + std::size_t{run.length});
+                }
+            },
+            right
+        );
+
+        return roaring_normalize(cpp_move(result));
+    }
+
+    [[nodiscard]] constexpr roaring_container
+        roaring_and(const roaring_container& left, const roaring_container& right)
+    {
+        const auto filter = [](const roaring_array_container& array, const roaring_container& other)
+        {
+            roaring_array_container result;
+            std::ranges::copy_if(
+                array.values,
+                std::back_inserter(result.values),
+                [&other](const u16 value) { return roaring_contains(other, value); }
+            );
+            return roaring_container{cpp_move(result)};
+        };
+
+        if(const auto* const array = std::get_if<roaring_array_container>(&left); array != nullptr)
+            return filter(*array, right);
+
+        if(const auto* const array = std::get_if<roaring_array_container>(&right); array != nullptr)
+            return filter(*array, left);
+
+        auto result = roaring_to_bitmap(left);
+        const auto other = roaring_to_bitmap(right);
+        std::size_t cardinality = 0;
+
+        for(std::size_t i = 0; i < roaring_bitmap_words; ++i)
+        {
+            result.words[i] &= other.words[i];
+            cardinality += std::popcount(result.words[i]);
+        }
+
+        result.cardinality = cardinality;
+        return roaring_normalize(cpp_move(result));
+    }
+
+    [[nodiscard]] constexpr roaring_run_container
+        roaring_to_runs(const roaring_container& container)
+    {
+        roaring_run_container result;
+
+        for(const auto value : roaring_to_array(container).values)
+            if(!result.runs.empty() &&
+               result.runs.back().start + std::size_t{result.runs.back().length} + 1 == value)
+                ++result.runs.back().length;
+            else result.runs.push_back({value, 0});
+
+        return result;
+    }
+}
+
+namespace stdsharp
+{
+    // compressed set of 32-bit integers. values are partitioned by their high 16 bits into chunks,
+    // each stored as a sorted array, a 2^16-bit bitmap or a list of runs, whichever is smaller.
+    // add and remove keep chunks as arrays or bitmaps, run_optimize converts chunks to runs
+    // where that saves space.
+    class roaring_bitmap
+    {
+        std::vector<u16> keys_;
+        std::vector<details::roaring_container> containers_;
+
+        [[nodiscard]] static constexpr u16 high(const u32 value) noexcept
+        {
+            return static_cast<u16>(value >> 16);
+        }
+
+        [[nodiscard]] static constexpr u16 low(const u32 value) noexcept
+        {
+            return static_cast<u16>(value);
+        }
+
+        [[nodiscard]] constexpr std::size_t find_key(const u16 key) const
+        {
+            return static_cast<std::size_t>(std::ranges::lower_bound(keys_, key) - keys_.begin());
+        }
+
+        template<typename Op>
+        static constexpr roaring_bitmap merge(
+            const roaring_bitmap& left,
+            const roaring_bitmap& right,
+            const Op op,
+            const bool keep_unmatched
+        )
+        {
+            roaring_bitmap result;
+            std::size_t i = 0;
+            std::size_t j = 0;
+
+            const auto push = [&result](const u16 key, details::roaring_container container)
+            {
+                if(details::roaring_cardinality(container) == 0) return;
+                result.keys_.push_back(key);
+                result.containers_.push_back(cpp_move(container));
+            };
+
+            while(i < left.keys_.size() && j < right.keys_.size())
+            {
+                const auto left_key = left.keys_[i];
+                const auto right_key = right.keys_[j];
+
+                if(left_key == right_key)
+                    push(left_key, op(left.containers_[i++], right.containers_[j++]));
+                else if(left_key < right_key)
+                {
+                    if(keep_unmatched) push(left_key, left.containers_[i]);
+                    ++i;
+                }
+                else
+                {
+                    if(keep_unmatched) push(right_key, right.containers_[j]);
+                    ++j;
+                }
+            }
+
+            if(keep_unmatched)
+            {
+                for(; i < left.keys_.size(); ++i) push(left.keys_[i], left.containers_[i]);
+                for(; j < right.keys_.size(); ++j) push(right.keys_[j], right.containers_[j]);
+            }
+
+            return result;
+        }
+
+    public:
+        using value_type = u32;
+        using size_type = std::size_t;
+
+        class const_iterator
+        {
+            friend class roaring_bitmap;
+
+            const roaring_bitmap* bitmap_ = nullptr;
+            std::size_t chunk_ = 0;
+            std::size_t index_ = 0;
+            u32 value_ = 0;
+
+            constexpr const_iterator(const roaring_bitmap& bitmap, const std::size_t chunk):
+                bitmap_(&bitmap), chunk_(chunk)
+            {
+                enter_chunk();
+            }
+
+            [[nodiscard]] constexpr u32 base() const
+            {
+                return static_cast<u32>(bitmap_->keys_[chunk_]) << 16;
+            }
+
+            constexpr void enter_chunk()
+            {
+                index_ = 0;
+
+                if(chunk_ >= bitmap_->keys_.size())
+                {
+                    value_ = 0;
+                    return;
+                }
+
+                const auto first = std::visit(
+                    details::roaring_visitor{
+                        [](const details::roaring_array_container& c)
+                        {
+                            return u32{c.values.front()}; //
+                        },
+                        [](const details::roaring_bitmap_container& c)
+                        {
+                            return static_cast<u32>(c.next(0)); //
+                        },
+                        [](const details::roaring_run_container& c)
+                        {
+                            return u32{c.runs.front().start}; //
+                        }
+                    },
+                    bitmap_->containers_[chunk_]
+                );
+
+                value_ = base() + first;
+            }
+
+            constexpr void next_chunk()
+            {
+                ++chunk_;
+                enter_chunk();
+            }
+
+        public:
+            using value_type = u32;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::forward_iterator_tag;
+
+            const_iterator() = default;
+
+            [[nodiscard]] constexpr u32 operator*() const noexcept { return value_; }
+
+            constexpr const_iterator& operator++()
+            {
+                const auto low = value_ & 0xffff;
+
+                std::visit(
+                    details::roaring_visitor{
+                        [this](const details::roaring_array_container& c)
+                        {
+                            if(++index_ == c.values.size()) next_chunk();
+                            else value_ = base() + c.values[index_];
+                        },
+                        [this, low](const details::roaring_bitmap_container& c)
+                        {
+                            const auto next = c.next(low + 1);
+                            if(next == details::roaring_chunk_size) next_chunk();
+                            else value_ = base() + static_cast<u32>(next);
+                        },
+                        [this, low](const details::roaring_run_container& c)
+                        {
+                            const auto run = c.runs[index_];
+                            if(low < run.start + u32{run.length}) ++value_;
+                            else if(++index_ == c.runs.size()) next_chunk();
+                            else value_ = base() + c.runs[index_].start;
+                        }
+                    },
+                    bitmap_->containers_[chunk_]
+                );
+
+                return *this;
+            }
+
+            constexpr const_iterator operator++(int)
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const const_iterator& other) const noexcept
+            {
+                return chunk_ == other.chunk_ && value_ == other.value_;
+            }
+        };
+
+        using iterator = const_iterator;
+
+        roaring_bitmap() = default;
+
+        constexpr roaring_bitmap(const std::initializer_list<u32> values)
+        {
+            for(const auto value : values) add(value);
+        }
+
+        template<std::input_iterator I, std::sentinel_for<I> S>
+            requires std::convertible_to<std::iter_reference_t<I>, u32>
+        constexpr roaring_bitmap(I first, const S last)
+        {
+            for(; first != last; ++first) add(*first);
+        }
+
+        // returns true if the value is newly added
+        constexpr bool add(const u32 value)
+        {
+            const auto index = find_key(high(value));
+
+            if(index == keys_.size() || keys_[index] != high(value))
+            {
+                keys_.insert(keys_.begin() + static_cast<std::ptrdiff_t>(index), high(value));
+                containers_.insert(
+                    containers_.begin() + static_cast<std::ptrdiff_t>(index),
+                    details::roaring_array_container{}
+                );
+            }
+
+            auto& container = containers_[index];
+
+            if(std::holds_alternative<details::roaring_run_container>(container))
+                container = details::roaring_normalize(cpp_move(container));
+
+            if(auto* const array = std::get_if<details::roaring_array_container>(&container);
+               array != nullptr)
+            {
+                auto& values = array->values;
+                const auto it = std::ranges::lower_bound(values, low(value));
+                if(it != values.end() && *it == low(value)) return false;
+
+                values.insert(it, low(value));
+                if(values.size() > details::roaring_array_max)
+                    container = details::roaring_to_bitmap(container);
+
+                return true;
+            }
+
+            return std::get<details::roaring_bitmap_container>(container).set(low(value));
+        }
+
+        // returns true if the value was present
+        constexpr bool remove(const u32 value)
+        {
+            const auto index = find_key(high(value));
+
+            if(index == keys_.size() || keys_[index] != high(value)) return false;
+
+            auto& container = containers_[index];
+
+            if(!details::roaring_contains(container, low(value))) return false;
+
+            if(std::holds_alternative<details::roaring_run_container>(container))
+                container = details::roaring_normalize(cpp_move(container));
+
+            if(auto* const array = std::get_if<details::roaring_array_container>(&container);
+               array != nullptr)
+                std::erase(array->values, low(value));
+            else
+            {
+                auto& bitmap = std::get<details::roaring_bitmap_container>(container);
+                bitmap.reset(low(value));
+                if(bitmap.cardinality <= details::roaring_array_max)
+                    container = details::roaring_to_array(container);
+            }
+
+            if(details::roaring_cardinality(container) == 0)
+            {
+                keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(index));
+                containers_.erase(containers_.begin() + static_cast<std::ptrdiff_t>(index));
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool contains(const u32 value) const
+        {
+            const auto index = find_key(high(value));
+            return index < keys_.size() && keys_[index] == high(value) &&
+                details::roaring_contains(containers_[index], low(value));
+        }
+
+        [[nodiscard]] constexpr size_type size() const
+        {
+            size_type size = 0;
+            for(const auto& container : containers_)
+                size += details::roaring_cardinality(container);
+            return size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept { return keys_.empty(); }
+
+        constexpr void clear() noexcept
+        {
+            keys_.clear();
+            containers_.clear();
+        }
+
+        // converts chunks to runs where runs take less space
+        constexpr void run_optimize()
+        {
+            for(auto& container : containers_)
+            {
+                auto runs = details::roaring_to_runs(container);
+                const auto run_bytes = runs.runs.size() * sizeof(details::roaring_run);
+                const auto bytes =
+                    std::holds_alternative<details::roaring_bitmap_container>(container) ?
+                    details::roaring_bitmap_words * sizeof(u64) :
+                    details::roaring_cardinality(container) * sizeof(u16);
+
+                if(run_bytes < bytes) container = cpp_move(runs);
+            }
+        }
+
+        [[nodiscard]] constexpr const_iterator begin() const { return {*this, 0}; }
+
+        [[nodiscard]] constexpr const_iterator end() const { return {*this, keys_.size()}; }
+
+        constexpr roaring_bitmap& operator|=(const roaring_bitmap& other)
+        {
+            return *this = *this | other;
+        }
+
+        constexpr roaring_bitmap& operator&=(const roaring_bitmap& other)
+        {
+            return *this = *this & other;
+        }
+
+        [[nodiscard]] friend constexpr roaring_bitmap
+            operator|(const roaring_bitmap& left, const roaring_bitmap& right)
+        {
+            return merge(left, right, details::roaring_or, true);
+        }
+
+        [[nodiscard]] friend constexpr roaring_bitmap
+            operator&(const roaring_bitmap& left, const roaring_bitmap& right)
+        {
+            return merge(left, right, details::roaring_and, false);
+        }
+
+        [[nodiscard]] friend constexpr bool
+            operator==(const roaring_bitmap& left, const roaring_bitmap& right)
+        {
+            return left.keys_ == right.keys_ && std::ranges::equal(left, right);
+        }
+
+        // little endian: u32 chunk count, then for each chunk u16 key, u8 kind (0 array,
+        // 1 bitmap, 2 runs), u32 element count and the elements
+        [[nodiscard]] std::vector<std::byte> serialize() const
+        {
+            std::vector<std::byte> bytes;
+
+            details::bitset_write(bytes, static_cast<u32>(keys_.size()));
+
+            for(std::size_t i = 0; i < keys_.size(); ++i)
+            {
+                details::bitset_write(bytes, keys_[i]);
+                details::bitset_write(bytes, static_cast<u8>(containers_[i].index()));
+
+                std::visit(
+                    details::roaring_visitor{
+                        [&bytes](const details::roaring_array_container& c)
+                        {
+                            details::bitset_write(bytes, static_cast<u32>(c.values.size()));
+                            for(const auto value : c.values) details::bitset_write(bytes, value);
+                        },
+                        [&bytes](const details::roaring_bitmap_container& c)
+                        {
+                            details::bitset_write(bytes, static_cast<u32>(c.words.size()));
+                            for(const auto word : c.words) details::bitset_write(bytes, word);
+                        },
+                        [&bytes](const details::roaring_run_container& c)
+                        {
+                            details::bitset_write(bytes, static_cast<u32>(c.runs.size()));
+                            for(const auto run : c.runs)
+                            {
+                                details::bitset_write(bytes, run.start);
+                                details::bitset_write(bytes, run.length);
+                            }
+                        }
+                    },
+                    containers_[i]
+                );
+            }
+
+            return bytes;
+        }
+
+        // throws std::invalid_argument on malformed input, including containers serialize would
+        // never produce: unordered values or runs, arrays above and bitmaps at or below
+        // roaring_array_max values, and bytes left after the last chunk
+        [[nodiscard]] static roaring_bitmap deserialize(std::span<const std::byte> bytes)
+        {
+            roaring_bitmap result;
+            const auto count = details::bitset_read<u32>(bytes);
+
+            for(u32 i = 0; i < count; ++i)
+            {
+                const auto key = details::bitset_read<u16>(bytes);
+                const auto kind = details::bitset_read<u8>(bytes);
+                const auto size = details::bitset_read<u32>(bytes);
+
+                if(!result.keys_.empty() && key <= result.keys_.back())
+                    throw std::invalid_argument{"unordered roaring bitmap keys"};
+
+                details::roaring_container container;
+
+                switch(kind)
+                {
+                case 0:
+                {
+                    if(size > details::roaring_array_max)
+                        throw std::invalid_argument{"invalid roaring array container size"};
+
+                    details::roaring_array_container array;
+                    for(u32 j = 0; j < size; ++j)
+                    {
+                        const auto value = details::bitset_read<u16>(bytes);
+
+                        if(!array.values.empty() && value <= array.values.back())
+                            throw std::invalid_argument{"unordered roaring array container"};
+
+                        array.values.push_back(value);
+                    }
+                    container = cpp_move(array);
+                    break;
+                }
+
+                case 1:
+                {
+                    if(size != details::roaring_bitmap_words)
+                        throw std::invalid_argument{"invalid roaring bitmap container size"};
+
+                    details::roaring_bitmap_container bitmap;
+                    for(auto& word : bitmap.words)
+                    {
+                        word = details::bitset_read<u64>(bytes);
+                        bitmap.cardinality += std::popcount(word);
+                    }
+
+                    if(bitmap.cardinality <= details::roaring_array_max)
+                        throw std::invalid_argument{"sparse roaring bitmap container"};
+
+                    container = cpp_move(bitmap);
+                    break;
+                }
+
+                case 2:
+                {
+                    details::roaring_run_container runs;
+                    for(u32 j = 0; j < size; ++j)
+                    {
+                        const auto start = details::bitset_read<u16>(bytes);
+                        const auto length = details::bitset_read<u16>(bytes);
+
+                        if(start + std::size_t{length} >= details::roaring_chunk_size)
+                            throw std::invalid_argument{"roaring run exceeds its chunk"};
+
+                        if(!runs.runs.empty() &&
+                           start <= runs.runs.back().start + std::size_t{runs.runs.back().length})
+                            throw std::invalid_argument{"unordered roaring runs"};
+
+                        runs.runs.push_back({start, length});
+                    }
+                    container = cpp_move(runs);
+                    break;
+                }
+
+                default: throw std::invalid_argument{"invalid roaring bitmap container kind"};
+                }
+
+                if(details::roaring_cardinality(container) == 0)
+                    throw std::invalid_argument{"empty roaring bitmap container"};
+
+                result.keys_.push_back(key);
+                result.containers_.push_back(cpp_move(container));
+            }
+
+            if(!bytes.empty()) throw std::invalid_argument{"trailing roaring bitmap bytes"};
+
+            return result;
+        }
+    };
+
+    inline constexpr struct roaring_crng_fn
+    {
+        [[nodiscard]] constexpr auto operator()(const roaring_bitmap& bitmap) const
+        {
+            return std::ranges::subrange{bitmap.begin(), bitmap.end()};
+        }
+    } roaring_crng{};
+}
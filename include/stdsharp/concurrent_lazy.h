@@ -0,0 +1,141 @@
+#pragma once
+
+#include "concepts/object.h"
+#include "cstdint/cstdint.h"
+#include "utility/forward_cast.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace stdsharp
+{
+    template<std::invocable Fn>
+    class concurrent_lazy // NOLINTBEGIN(*-noexcept-*)
+    {
+    public:
+        using value_type = std::invoke_result_t<Fn>;
+
+    private:
+        enum class state : u8
+        {
+            empty,
+            generating,
+            ready,
+            failed
+        };
+
+        std::atomic<state> state_ = state::empty;
+
+        union
+        {
+            Fn fn_{};
+            value_type value_;
+            std::exception_ptr error_;
+        };
+
+        void generate_value()
+        {
+            for(auto current = state_.load(std::memory_order_acquire); current != state::ready;
+                current = state_.load(std::memory_order_acquire))
+            {
+                if(current == state::generating)
+                {
+                    state_.wait(current, std::memory_order_acquire);
+                    continue;
+                }
+
+                if(current == state::failed) std::rethrow_exception(error_);
+
+                if(!state_.compare_exchange_strong(
+                       current,
+                       state::generating,
+                       std::memory_order_acquire,
+                       std::memory_order_acquire
+                   ))
+                    continue;
+
+                auto consumed = false;
+
+                try
+                {
+                    auto&& v = std::invoke(cpp_move(fn_));
+                    std::ranges::destroy_at(&fn_);
+                    consumed = true;
+                    std::ranges::construct_at(&value_, cpp_move(v));
+                }
+                catch(...)
+                {
+                    // once fn_ is destroyed there is nothing to retry, later calls rethrow instead
+                    if(consumed) std::ranges::construct_at(&error_, std::current_exception());
+
+                    state_.store(
+                        consumed ? state::failed : state::empty,
+                        std::memory_order_release
+                    );
+                    state_.notify_all();
+                    throw;
+                }
+
+                state_.store(state::ready, std::memory_order_release);
+                state_.notify_all();
+                return;
+            }
+        }
+
+    public:
+        concurrent_lazy() = default;
+
+        template<typename... Args>
+            requires std::constructible_from<Fn, Args...>
+        explicit(sizeof...(Args) == 1) concurrent_lazy(Args&&... args)
+            noexcept(nothrow_constructible_from<Fn, Args...>):
+            fn_(cpp_forward(args)...)
+        {
+        }
+
+        concurrent_lazy(const concurrent_lazy&) = delete;
+        concurrent_lazy(concurrent_lazy&&) = delete;
+        concurrent_lazy& operator=(const concurrent_lazy&) = delete;
+        concurrent_lazy& operator=(concurrent_lazy&&) = delete;
+
+        ~concurrent_lazy()
+        {
+            switch(state_.load(std::memory_order_acquire))
+            {
+            case state::ready: std::ranges::destroy_at(&value_); break;
+            case state::failed: std::ranges::destroy_at(&error_); break;
+            default: std::ranges::destroy_at(&fn_); break;
+            }
+        }
+
+        [[nodiscard]] bool has_value() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) == state::ready;
+        }
+
+        template<typename Self>
+            requires non_const<std::remove_reference_t<Self>>
+        decltype(auto) get(this Self&& self)
+        {
+            auto&& this_ = forward_cast<Self, concurrent_lazy>(self);
+            if(!this_.has_value()) [[unlikely]] this_.generate_value();
+            return (cpp_forward(this_).value_);
+        }
+
+        template<typename Self>
+        decltype(auto) cget(this const Self&& self) noexcept
+        {
+            return (forward_cast<const Self, concurrent_lazy>(self).value_);
+        }
+
+        template<typename Self>
+        decltype(auto) cget(this const Self& self) noexcept
+        {
+            return (forward_cast<const Self&, concurrent_lazy>(self).value_);
+        }
+    }; // NOLINTEND(*-noexcept-*)
+
+    template<typename Fn>
+    concurrent_lazy(Fn&&) -> concurrent_lazy<std::decay_t<Fn>>;
+}
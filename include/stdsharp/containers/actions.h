@@ -6,6 +6,7 @@
 #include <range/v3/action.hpp>
 
 #include <algorithm>
+#include <optional>
 
 namespace stdsharp::actions::details
 {
@@ -240,6 +241,84 @@ namespace stdsharp::actions
 #undef STDSHARP_POP_WHERE_ACTION
 }
 
+namespace stdsharp::actions::details
+{
+    struct try_emplace_back_mem_fn
+    {
+        template<typename Container, typename... Args>
+        constexpr bool operator()(Container& container, Args&&... args) const
+            requires requires {
+                {
+                    container.try_emplace_back(std::declval<Args>()...)
+                } -> std::same_as<bool>;
+            }
+        {
+            return container.try_emplace_back(cpp_forward(args)...);
+        }
+    };
+
+    struct try_emplace_back_default_fn
+    {
+        template<typename Container, typename... Args>
+            requires std::invocable<emplace_back_fn, Container&, Args...>
+        constexpr bool operator()(Container& container, Args&&... args) const
+        {
+            emplace_back(container, cpp_forward(args)...);
+            return true;
+        }
+    };
+
+    struct try_pop_front_mem_fn
+    {
+        template<typename Container>
+        constexpr auto operator()(Container& container) const
+            requires requires {
+                {
+                    container.try_pop_front()
+                } -> std::same_as<std::optional<typename Container::value_type>>;
+            }
+        {
+            return container.try_pop_front();
+        }
+    };
+
+    struct try_pop_front_default_fn
+    {
+        template<typename Container>
+            requires requires(Container& container) {
+                requires std::invocable<pop_front_fn, Container&>;
+                { container.empty() } -> std::convertible_to<bool>;
+                container.front();
+            }
+        constexpr auto operator()(Container& container) const
+        {
+            using value_type = Container::value_type;
+
+            if(container.empty()) return std::optional<value_type>{};
+
+            std::optional<value_type> res{cpp_move(container.front())};
+            pop_front(container);
+            return res;
+        }
+    };
+}
+
+namespace stdsharp::actions
+{
+    // returns false instead of blocking when the container can't accept the value
+    using try_emplace_back_fn = sequenced_invocables<
+        details::try_emplace_back_mem_fn,
+        details::try_emplace_back_default_fn>;
+
+    inline constexpr try_emplace_back_fn try_emplace_back{};
+
+    // returns an empty optional when there's no element to pop
+    using try_pop_front_fn =
+        sequenced_invocables<details::try_pop_front_mem_fn, details::try_pop_front_default_fn>;
+
+    inline constexpr try_pop_front_fn try_pop_front{};
+}
+
 namespace stdsharp::actions::details
 {
     template<typename Container>
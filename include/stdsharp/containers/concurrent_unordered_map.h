@@ -0,0 +1,769 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../cstdint/cstdint.h"
+#include "../memory/aligned.h"
+#include "concepts.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+
+namespace stdsharp
+{
+    // hash map split into lock-striped std::unordered_map shards, each guarded by its own shared
+    // mutex on its own cache line. lookups only take a shared lock on one stripe, so readers never
+    // block each other and writers only contend within a stripe.
+    //
+    // find(key, fn), insert_or_assign, try_emplace, erase(key), erase_if, contains, count, size and
+    // empty are safe to call concurrently. the rest of the unordered associative container
+    // interface, i.e. everything dealing with iterators, node handles, buckets or the whole table,
+    // is the single-threaded view.
+    template<
+        typename Key,
+        typename T,
+        typename Hash = std::hash<Key>,
+        typename KeyEqual = std::equal_to<Key>,
+        typename Allocator = std::allocator<std::pair<const Key, T>>,
+        std::size_t StripeCount = 64>
+        requires(std::has_single_bit(StripeCount))
+    class concurrent_unordered_map
+    {
+        using map_type = std::unordered_map<Key, T, Hash, KeyEqual, Allocator>;
+
+        struct alignas(cache_line_size) stripe
+        {
+            mutable std::shared_mutex mutex{};
+            map_type map;
+        };
+
+        using stripes_type = std::array<stripe, StripeCount>;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = map_type::value_type;
+        using size_type = map_type::size_type;
+        using difference_type = map_type::difference_type;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = Allocator;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = allocator_traits<Allocator>::pointer;
+        using const_pointer = allocator_traits<Allocator>::const_pointer;
+        using local_iterator = map_type::local_iterator;
+        using const_local_iterator = map_type::const_local_iterator;
+        using node_type = map_type::node_type;
+
+        static constexpr auto stripe_count = StripeCount;
+
+    private:
+        template<bool IsConst>
+        class iterator_impl
+        {
+            friend class concurrent_unordered_map;
+
+            using stripes_ptr = std::conditional_t<IsConst, const stripes_type*, stripes_type*>;
+            using inner_iterator = std::conditional_t<
+                IsConst,
+                typename map_type::const_iterator,
+                typename map_type::iterator>;
+
+            stripes_ptr stripes_ = nullptr;
+            std::size_t index_ = 0;
+            inner_iterator it_{};
+
+            constexpr iterator_impl(
+                const stripes_ptr stripes,
+                const std::size_t index,
+                const inner_iterator it
+            ):
+                stripes_(stripes), index_(index), it_(it)
+            {
+                skip_empty();
+            }
+
+            constexpr void skip_empty()
+            {
+                while(it_ == (*stripes_)[index_].map.end() && index_ + 1 < StripeCount)
+                    it_ = (*stripes_)[++index_].map.begin();
+            }
+
+        public:
+            using value_type = concurrent_unordered_map::value_type;
+            using difference_type = concurrent_unordered_map::difference_type;
+            using pointer = std::iterator_traits<inner_iterator>::pointer;
+            using reference = std::iterator_traits<inner_iterator>::reference;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator_impl() = default;
+
+            constexpr iterator_impl(const iterator_impl<!IsConst>& other) noexcept
+                requires IsConst
+                : stripes_(other.stripes_), index_(other.index_), it_(other.it_)
+            {
+            }
+
+            [[nodiscard]] constexpr reference operator*() const noexcept { return *it_; }
+
+            [[nodiscard]] constexpr pointer operator->() const noexcept { return &*it_; }
+
+            constexpr iterator_impl& operator++()
+            {
+                ++it_;
+                skip_empty();
+                return *this;
+            }
+
+            constexpr iterator_impl operator++(int)
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator_impl& other) const noexcept
+            {
+                return index_ == other.index_ && it_ == other.it_;
+            }
+        };
+
+    public:
+        using iterator = iterator_impl<false>;
+        using const_iterator = iterator_impl<true>;
+
+        struct insert_return_type
+        {
+            iterator position;
+            bool inserted;
+            node_type node;
+        };
+
+    private:
+        stripes_type stripes_;
+
+        template<typename... Args>
+        static constexpr stripes_type make_stripes(const Args&... args)
+        {
+            const auto make = [&](const std::size_t) { return stripe{.map = map_type(args...)}; };
+
+            return [&]<std::size_t... I>(const std::index_sequence<I...>)
+            {
+                return stripes_type{make(I)...};
+            }(std::make_index_sequence<StripeCount>{});
+        }
+
+        template<typename Other, typename... Args>
+        static constexpr stripes_type make_stripes_from(Other&& other, const Args&... args)
+        {
+            return [&]<std::size_t... I>(const std::index_sequence<I...>)
+            {
+                return stripes_type{
+                    stripe{.map = map_type(cpp_forward(other).stripes_[I].map, args...)}...
+                };
+            }(std::make_index_sequence<StripeCount>{});
+        }
+
+        [[nodiscard]] constexpr std::size_t stripe_index(const key_type& key) const
+        {
+            if constexpr(StripeCount == 1) return 0;
+            else
+            {
+                // fibonacci hashing takes the high bits, while the shards index buckets by the
+                // low bits or a prime modulo
+                constexpr auto shift = 64 - std::countr_zero(StripeCount);
+                return static_cast<std::size_t>(
+                    (static_cast<u64>(hash_function()(key)) * 0x9E37'79B9'7F4A'7C15ULL) >> shift
+                );
+            }
+        }
+
+        [[nodiscard]] constexpr stripe& stripe_of(const key_type& key)
+        {
+            return stripes_[stripe_index(key)];
+        }
+
+        [[nodiscard]] constexpr const stripe& stripe_of(const key_type& key) const
+        {
+            return stripes_[stripe_index(key)];
+        }
+
+        [[nodiscard]] constexpr iterator make_iterator(
+            const std::size_t index,
+            const typename map_type::iterator it
+        )
+        {
+            return {&stripes_, index, it};
+        }
+
+        [[nodiscard]] constexpr const_iterator make_iterator(
+            const std::size_t index,
+            const typename map_type::const_iterator it
+        ) const
+        {
+            return {&stripes_, index, it};
+        }
+
+        [[nodiscard]] constexpr auto to_mutable(const const_iterator it)
+        {
+            auto& map = stripes_[it.index_].map;
+            return map.erase(it.it_, it.it_);
+        }
+
+        // global bucket index to stripe and stripe local bucket
+        [[nodiscard]] constexpr std::pair<std::size_t, size_type> locate_bucket(size_type n
+        ) const
+        {
+            for(std::size_t i = 0;; ++i)
+            {
+                const auto count = stripes_[i].map.bucket_count();
+                if(n < count) return {i, n};
+                n -= count;
+            }
+        }
+
+        [[nodiscard]] constexpr size_type bucket_offset(const std::size_t index) const
+        {
+            size_type offset = 0;
+            for(std::size_t i = 0; i < index; ++i) offset += stripes_[i].map.bucket_count();
+            return offset;
+        }
+
+        [[nodiscard]] static constexpr size_type stripe_bucket_count(const size_type bucket_count)
+        {
+            return (bucket_count + StripeCount - 1) / StripeCount;
+        }
+
+        constexpr std::pair<iterator, bool> emplace_value(value_type&& value)
+        {
+            const auto index = stripe_index(value.first);
+            auto& s = stripes_[index];
+            const std::unique_lock lock{s.mutex};
+            const auto [it, inserted] = s.map.insert(cpp_move(value));
+            return {make_iterator(index, it), inserted};
+        }
+
+    public:
+        concurrent_unordered_map(): concurrent_unordered_map(size_type{0}) {}
+
+        explicit concurrent_unordered_map(
+            const size_type bucket_count,
+            const hasher& hash = hasher(),
+            const key_equal& equal = key_equal(),
+            const allocator_type& alloc = allocator_type()
+        ):
+            stripes_(make_stripes(stripe_bucket_count(bucket_count), hash, equal, alloc))
+        {
+        }
+
+        concurrent_unordered_map(const size_type bucket_count, const allocator_type& alloc):
+            concurrent_unordered_map(bucket_count, hasher(), key_equal(), alloc)
+        {
+        }
+
+        concurrent_unordered_map(
+            const size_type bucket_count,
+            const hasher& hash,
+            const allocator_type& alloc
+        ):
+            concurrent_unordered_map(bucket_count, hash, key_equal(), alloc)
+        {
+        }
+
+        explicit concurrent_unordered_map(const allocator_type& alloc):
+            concurrent_unordered_map(0, hasher(), key_equal(), alloc)
+        {
+        }
+
+        template<std::input_iterator InputIt>
+        concurrent_unordered_map(
+            const InputIt first,
+            const InputIt last,
+            const size_type bucket_count = 0,
+            const hasher& hash = hasher(),
+            const key_equal& equal = key_equal(),
+            const allocator_type& alloc = allocator_type()
+        ):
+            concurrent_unordered_map(bucket_count, hash, equal, alloc)
+        {
+            insert(first, last);
+        }
+
+        concurrent_unordered_map(
+            const std::initializer_list<value_type> il,
+            const size_type bucket_count = 0,
+            const hasher& hash = hasher(),
+            const key_equal& equal = key_equal(),
+            const allocator_type& alloc = allocator_type()
+        ):
+            concurrent_unordered_map(il.begin(), il.end(), bucket_count, hash, equal, alloc)
+        {
+        }
+
+        template<compatible_range<value_type> R>
+        concurrent_unordered_map(
+            const std::from_range_t /*unused*/,
+            R&& range,
+            const size_type bucket_count = 0,
+            const hasher& hash = hasher(),
+            const key_equal& equal = key_equal(),
+            const allocator_type& alloc = allocator_type()
+        ):
+            concurrent_unordered_map(bucket_count, hash, equal, alloc)
+        {
+            insert_range(cpp_forward(range));
+        }
+
+        concurrent_unordered_map(const concurrent_unordered_map& other):
+            stripes_(make_stripes_from(other))
+        {
+        }
+
+        concurrent_unordered_map(concurrent_unordered_map&& other):
+            stripes_(make_stripes_from(cpp_move(other)))
+        {
+        }
+
+        concurrent_unordered_map(
+            const concurrent_unordered_map& other,
+            const allocator_type& alloc
+        ):
+            stripes_(make_stripes_from(other, alloc))
+        {
+        }
+
+        concurrent_unordered_map(concurrent_unordered_map&& other, const allocator_type& alloc):
+            stripes_(make_stripes_from(cpp_move(other), alloc))
+        {
+        }
+
+        concurrent_unordered_map& operator=(const concurrent_unordered_map& other)
+        {
+            if(this != &other)
+                for(std::size_t i = 0; i < StripeCount; ++i)
+                    stripes_[i].map = other.stripes_[i].map;
+            return *this;
+        }
+
+        concurrent_unordered_map& operator=(concurrent_unordered_map&& other) noexcept(
+            nothrow_move_assignable<map_type>
+        )
+        {
+            if(this != &other)
+                for(std::size_t i = 0; i < StripeCount; ++i)
+                    stripes_[i].map = cpp_move(other.stripes_[i].map);
+            return *this;
+        }
+
+        concurrent_unordered_map& operator=(const std::initializer_list<value_type> il)
+        {
+            clear();
+            insert(il);
+            return *this;
+        }
+
+        ~concurrent_unordered_map() = default;
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept
+        {
+            return stripes_.front().map.get_allocator();
+        }
+
+        [[nodiscard]] hasher hash_function() const { return stripes_.front().map.hash_function(); }
+
+        [[nodiscard]] key_equal key_eq() const { return stripes_.front().map.key_eq(); }
+
+        // concurrent interface
+
+        // invokes fn with the element under a shared lock, returns whether the key is found
+        template<std::invocable<const_reference> Fn>
+        bool find(const key_type& key, Fn&& fn) const
+        {
+            const auto& s = stripe_of(key);
+            const std::shared_lock lock{s.mutex};
+
+            if(const auto it = s.map.find(key); it != s.map.end())
+            {
+                std::invoke(cpp_forward(fn), *it);
+                return true;
+            }
+
+            return false;
+        }
+
+        // invokes fn with the element under an exclusive lock, returns whether the key is found
+        template<std::invocable<reference> Fn>
+        bool visit(const key_type& key, Fn&& fn)
+        {
+            auto& s = stripe_of(key);
+            const std::unique_lock lock{s.mutex};
+
+            if(const auto it = s.map.find(key); it != s.map.end())
+            {
+                std::invoke(cpp_forward(fn), *it);
+                return true;
+            }
+
+            return false;
+        }
+
+        // returns true if inserted, false if assigned
+        template<typename M>
+            requires std::assignable_from<T&, M>
+        bool insert_or_assign(const key_type& key, M&& obj)
+        {
+            auto& s = stripe_of(key);
+            const std::unique_lock lock{s.mutex};
+            return s.map.insert_or_assign(key, cpp_forward(obj)).second;
+        }
+
+        template<typename M>
+            requires std::assignable_from<T&, M>
+        bool insert_or_assign(key_type&& key, M&& obj)
+        {
+            auto& s = stripe_of(key);
+            const std::unique_lock lock{s.mutex};
+            return s.map.insert_or_assign(cpp_move(key), cpp_forward(obj)).second;
+        }
+
+        // returns true if inserted, args are left untouched if the key exists
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        bool try_emplace(const key_type& key, Args&&... args)
+        {
+            auto& s = stripe_of(key);
+            const std::unique_lock lock{s.mutex};
+            return s.map.try_emplace(key, cpp_forward(args)...).second;
+        }
+
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        bool try_emplace(key_type&& key, Args&&... args)
+        {
+            auto& s = stripe_of(key);
+            const std::unique_lock lock{s.mutex};
+            return s.map.try_emplace(cpp_move(key), cpp_forward(args)...).second;
+        }
+
+        size_type erase(const key_type& key)
+        {
+            auto& s = stripe_of(key);
+            const std::unique_lock lock{s.mutex};
+            return s.map.erase(key);
+        }
+
+        // locks one stripe at a time, so it's not atomic with respect to the whole map
+        template<std::predicate<const_reference> Predicate>
+        size_type erase_if(Predicate predicate)
+        {
+            size_type count = 0;
+            for(auto& s : stripes_)
+            {
+                const std::unique_lock lock{s.mutex};
+                count += std::erase_if(s.map, std::ref(predicate));
+            }
+            return count;
+        }
+
+        template<std::predicate<const_reference> Predicate>
+        friend size_type erase_if(concurrent_unordered_map& map, Predicate predicate)
+        {
+            return map.erase_if(cpp_move(predicate));
+        }
+
+        [[nodiscard]] size_type count(const key_type& key) const
+        {
+            const auto& s = stripe_of(key);
+            const std::shared_lock lock{s.mutex};
+            return s.map.count(key);
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            const auto& s = stripe_of(key);
+            const std::shared_lock lock{s.mutex};
+            return s.map.contains(key);
+        }
+
+        // approximate under concurrent modification
+        [[nodiscard]] size_type size() const
+        {
+            size_type size = 0;
+            for(const auto& s : stripes_)
+            {
+                const std::shared_lock lock{s.mutex};
+                size += s.map.size();
+            }
+            return size;
+        }
+
+        [[nodiscard]] bool empty() const { return size() == 0; }
+
+        [[nodiscard]] size_type max_size() const noexcept
+        {
+            return stripes_.front().map.max_size();
+        }
+
+        // single-threaded interface
+
+        [[nodiscard]] iterator begin() noexcept
+        {
+            return make_iterator(0, stripes_.front().map.begin());
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return make_iterator(0, stripes_.front().map.begin());
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return make_iterator(StripeCount - 1, stripes_.back().map.end());
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return make_iterator(StripeCount - 1, stripes_.back().map.end());
+        }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+
+        [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+        void clear() noexcept
+        {
+            for(auto& s : stripes_) s.map.clear();
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            return emplace_value(value_type(value));
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return emplace_value(cpp_move(value));
+        }
+
+        iterator insert(const const_iterator /*unused*/, const value_type& value)
+        {
+            return insert(value).first;
+        }
+
+        iterator insert(const const_iterator /*unused*/, value_type&& value)
+        {
+            return insert(cpp_move(value)).first;
+        }
+
+        template<std::input_iterator InputIt>
+        void insert(InputIt first, const InputIt last)
+        {
+            for(; first != last; ++first) emplace(*first);
+        }
+
+        void insert(const std::initializer_list<value_type> il) { insert(il.begin(), il.end()); }
+
+        template<compatible_range<value_type> R>
+        void insert_range(R&& range)
+        {
+            for(auto&& value : range) emplace(cpp_forward(value));
+        }
+
+        insert_return_type insert(node_type&& node)
+        {
+            if(node.empty()) return {end(), false, {}};
+
+            const auto index = stripe_index(node.key());
+            auto [it, inserted, n] = stripes_[index].map.insert(cpp_move(node));
+            return {make_iterator(index, it), inserted, cpp_move(n)};
+        }
+
+        iterator insert(const const_iterator /*unused*/, node_type&& node)
+        {
+            return insert(cpp_move(node)).position;
+        }
+
+        template<typename... Args>
+            requires std::constructible_from<value_type, Args...>
+        std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            return emplace_value(value_type(cpp_forward(args)...));
+        }
+
+        template<typename... Args>
+            requires std::constructible_from<value_type, Args...>
+        iterator emplace_hint(const const_iterator /*unused*/, Args&&... args)
+        {
+            return emplace(cpp_forward(args)...).first;
+        }
+
+        iterator erase(const const_iterator pos)
+        {
+            return make_iterator(pos.index_, stripes_[pos.index_].map.erase(pos.it_));
+        }
+
+        iterator erase(const iterator pos) { return erase(const_iterator{pos}); }
+
+        iterator erase(const_iterator first, const const_iterator last)
+        {
+            while(first != last) first = erase(first);
+            return make_iterator(last.index_, to_mutable(last));
+        }
+
+        node_type extract(const const_iterator pos)
+        {
+            return stripes_[pos.index_].map.extract(pos.it_);
+        }
+
+        node_type extract(const key_type& key) { return stripe_of(key).map.extract(key); }
+
+        void merge(concurrent_unordered_map& source)
+        {
+            for(auto& s : source.stripes_)
+                for(auto it = s.map.begin(); it != s.map.end();)
+                {
+                    const auto index = stripe_index(it->first);
+                    if(stripes_[index].map.contains(it->first))
+                    {
+                        ++it;
+                        continue;
+                    }
+                    stripes_[index].map.insert(s.map.extract(it++));
+                }
+        }
+
+        void merge(concurrent_unordered_map&& source) { merge(source); }
+
+        void swap(concurrent_unordered_map& other) noexcept(nothrow_swappable<map_type>)
+        {
+            for(std::size_t i = 0; i < StripeCount; ++i)
+                std::ranges::swap(stripes_[i].map, other.stripes_[i].map);
+        }
+
+        friend void swap(concurrent_unordered_map& left, concurrent_unordered_map& right)
+            noexcept(nothrow_swappable<map_type>)
+        {
+            left.swap(right);
+        }
+
+        [[nodiscard]] iterator find(const key_type& key)
+        {
+            const auto index = stripe_index(key);
+            return make_iterator(index, stripes_[index].map.find(key));
+        }
+
+        [[nodiscard]] const_iterator find(const key_type& key) const
+        {
+            const auto index = stripe_index(key);
+            return make_iterator(index, stripes_[index].map.find(key));
+        }
+
+        [[nodiscard]] std::pair<iterator, iterator> equal_range(const key_type& key)
+        {
+            const auto it = find(key);
+            return {it, it == end() ? it : std::ranges::next(it)};
+        }
+
+        [[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(const key_type& key
+        ) const
+        {
+            const auto it = find(key);
+            return {it, it == end() ? it : std::ranges::next(it)};
+        }
+
+        [[nodiscard]] size_type bucket_count() const noexcept
+        {
+            return bucket_offset(StripeCount);
+        }
+
+        [[nodiscard]] size_type max_bucket_count() const noexcept
+        {
+            return stripes_.front().map.max_bucket_count();
+        }
+
+        [[nodiscard]] size_type bucket_size(const size_type n) const
+        {
+            const auto [index, local] = locate_bucket(n);
+            return stripes_[index].map.bucket_size(local);
+        }
+
+        [[nodiscard]] size_type bucket(const key_type& key) const
+        {
+            const auto index = stripe_index(key);
+            return bucket_offset(index) + stripes_[index].map.bucket(key);
+        }
+
+        [[nodiscard]] local_iterator begin(const size_type n)
+        {
+            const auto [index, local] = locate_bucket(n);
+            return stripes_[index].map.begin(local);
+        }
+
+        [[nodiscard]] const_local_iterator begin(const size_type n) const
+        {
+            const auto [index, local] = locate_bucket(n);
+            return stripes_[index].map.begin(local);
+        }
+
+        [[nodiscard]] local_iterator end(const size_type n)
+        {
+            const auto [index, local] = locate_bucket(n);
+            return stripes_[index].map.end(local);
+        }
+
+        [[nodiscard]] const_local_iterator end(const size_type n) const
+        {
+            const auto [index, local] = locate_bucket(n);
+            return stripes_[index].map.end(local);
+        }
+
+        [[nodiscard]] const_local_iterator cbegin(const size_type n) const { return begin(n); }
+
+        [[nodiscard]] const_local_iterator cend(const size_type n) const { return end(n); }
+
+        [[nodiscard]] float load_factor() const
+        {
+            return static_cast<float>(size()) / static_cast<float>(bucket_count());
+        }
+
+        [[nodiscard]] float max_load_factor() const noexcept
+        {
+            return stripes_.front().map.max_load_factor();
+        }
+
+        void max_load_factor(const float ml)
+        {
+            for(auto& s : stripes_) s.map.max_load_factor(ml);
+        }
+
+        void rehash(const size_type count)
+        {
+            for(auto& s : stripes_) s.map.rehash(stripe_bucket_count(count));
+        }
+
+        void reserve(const size_type count)
+        {
+            for(auto& s : stripes_) s.map.reserve(stripe_bucket_count(count));
+        }
+
+        [[nodiscard]] friend bool
+            operator==(const concurrent_unordered_map& left, const concurrent_unordered_map& right)
+            requires std::equality_comparable<T>
+        {
+            if(left.size() != right.size()) return false;
+
+            return std::ranges::all_of(
+                left,
+                [&right](const_reference value)
+                {
+                    const auto it = right.find(value.first);
+                    return it != right.end() && it->second == value.second;
+                }
+            );
+        }
+    };
+}
@@ -1,4 +1,7 @@
 #pragma once
 
 #include "actions.h" // IWYU pragma: export
-#include "concepts.h" // IWYU pragma: export
\ No newline at end of file
+#include "concepts.h" // IWYU pragma: export
+#include "concurrent_unordered_map.h" // IWYU pragma: export
+#include "mpmc_queue.h" // IWYU pragma: export
+#include "spsc_queue.h" // IWYU pragma: export
\ No newline at end of file
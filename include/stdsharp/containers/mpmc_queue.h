@@ -0,0 +1,177 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../concepts/object.h"
+#include "../memory/aligned.h"
+#include "../memory/allocator_traits.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+
+#include "../compilation_config_in.h"
+
+namespace stdsharp
+{
+    // bounded multi-producer multi-consumer queue from Dmitry Vyukov's design, every slot carries
+    // a sequence number telling whether it's ready for the next producer or consumer
+    template<nothrow_move_constructible T, allocator_req Allocator = std::allocator<T>>
+    class mpmc_queue
+    {
+        struct alignas(cache_line_size) slot
+        {
+            std::atomic_size_t sequence;
+            alignas(T) std::array<std::byte, sizeof(T)> storage;
+
+            [[nodiscard]] T& get() noexcept
+            {
+                return *std::launder(reinterpret_cast<T*>(storage.data())); // NOLINT
+            }
+        };
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using allocator_type = allocator_traits<Allocator>::template rebind_alloc<slot>;
+
+    private:
+        using alloc_traits = allocator_traits<allocator_type>;
+
+        alignas(cache_line_size) std::atomic_size_t enqueue_pos_ = 0;
+        alignas(cache_line_size) std::atomic_size_t dequeue_pos_ = 0;
+        alignas(cache_line_size) size_type mask_;
+        STDSHARP_NO_UNIQUE_ADDRESS allocator_type alloc_;
+        slot* slots_;
+
+        template<typename... Args>
+        bool emplace_impl(Args&&... args) noexcept
+        {
+            auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+            slot* s = nullptr;
+
+            while(true)
+            {
+                s = &slots_[pos & mask_]; // NOLINT(*-pointer-arithmetic)
+
+                const auto diff = static_cast<std::ptrdiff_t>(
+                    s->sequence.load(std::memory_order_acquire) - pos
+                );
+
+                if(diff == 0)
+                {
+                    if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if(diff < 0) return false;
+                else pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+
+            std::ranges::construct_at(
+                reinterpret_cast<T*>(s->storage.data()), // NOLINT(*-reinterpret-cast)
+                cpp_forward(args)...
+            );
+            s->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]] bool next_slot_busy() const noexcept
+        {
+            const auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+            const auto& s = slots_[pos & mask_]; // NOLINT(*-pointer-arithmetic)
+
+            const auto diff = s.sequence.load(std::memory_order_acquire) - pos;
+
+            return static_cast<std::ptrdiff_t>(diff) < 0;
+        }
+
+    public:
+        explicit mpmc_queue(const size_type capacity, const Allocator& alloc = Allocator{}):
+            mask_(std::bit_ceil(capacity) - 1),
+            alloc_(alloc),
+            slots_(alloc_traits::allocate(alloc_, mask_ + 1))
+        {
+            Expects(capacity > 1);
+
+            for(size_type i = 0; i <= mask_; ++i)
+                std::ranges::construct_at(&slots_[i])->sequence.store(i, std::memory_order_relaxed);
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue(mpmc_queue&&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+        ~mpmc_queue()
+        {
+            while(try_pop_front().has_value()) {}
+            alloc_traits::deallocate(alloc_, slots_, mask_ + 1);
+        }
+
+        // returns false if the queue is full. if T's constructor may throw, the value is built
+        // before a slot is claimed, so a call that finds a free slot but then loses it to another
+        // producer returns false after args have been consumed
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        [[nodiscard]] bool try_emplace_back(Args&&... args)
+            noexcept(nothrow_constructible_from<T, Args...>)
+        {
+            if constexpr(nothrow_constructible_from<T, Args...>)
+                return emplace_impl(cpp_forward(args)...);
+            else
+            {
+                if(next_slot_busy()) return false;
+
+                // construct ahead so that a throwing constructor can't leave a slot claimed
+                T value(cpp_forward(args)...);
+                return emplace_impl(cpp_move(value));
+            }
+        }
+
+        [[nodiscard]] std::optional<T> try_pop_front() noexcept
+        {
+            auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+            slot* s = nullptr;
+
+            while(true)
+            {
+                s = &slots_[pos & mask_]; // NOLINT(*-pointer-arithmetic)
+
+                const auto diff = static_cast<std::ptrdiff_t>(
+                    s->sequence.load(std::memory_order_acquire) - (pos + 1)
+                );
+
+                if(diff == 0)
+                {
+                    if(dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if(diff < 0) return std::nullopt;
+                else pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+
+            auto& value = s->get();
+            std::optional<T> res{cpp_move(value)};
+            std::ranges::destroy_at(&value);
+            s->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            return res;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return mask_ + 1; }
+
+        // approximate when accessed concurrently
+        [[nodiscard]] size_type size() const noexcept
+        {
+            const auto dequeue = dequeue_pos_.load(std::memory_order_relaxed);
+            const auto enqueue = enqueue_pos_.load(std::memory_order_relaxed);
+            return enqueue > dequeue ? enqueue - dequeue : 0;
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept { return alloc_; }
+    };
+}
+
+#include "../compilation_config_out.h"
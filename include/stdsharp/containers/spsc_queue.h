@@ -0,0 +1,183 @@
+#pragma once
+
+#include "../algorithm/algorithm.h"
+#include "../cassert/cassert.h"
+#include "../memory/aligned.h"
+#include "../memory/allocator_traits.h"
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+
+#include "../compilation_config_in.h"
+
+namespace stdsharp
+{
+    // wait-free single-producer single-consumer ring. slots hold default constructed values so
+    // that batches are moved in and out with move_n, popped slots keep moved-from values until
+    // they're overwritten. each side caches the other side's index and only reloads it when the
+    // cached one says the ring is full or empty.
+    template<typename T, allocator_req Allocator = std::allocator<T>>
+        requires std::default_initializable<T> && std::movable<T>
+    class spsc_queue
+    {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using allocator_type = allocator_traits<Allocator>::template rebind_alloc<T>;
+
+        template<typename I>
+        struct batch_result
+        {
+            I iterator;
+            size_type count;
+        };
+
+    private:
+        using alloc_traits = allocator_traits<allocator_type>;
+
+        // producer line
+        alignas(cache_line_size) std::atomic_size_t tail_ = 0;
+        size_type cached_head_ = 0;
+
+        // consumer line
+        alignas(cache_line_size) std::atomic_size_t head_ = 0;
+        size_type cached_tail_ = 0;
+
+        alignas(cache_line_size) size_type mask_;
+        STDSHARP_NO_UNIQUE_ADDRESS allocator_type alloc_;
+        T* data_;
+
+        [[nodiscard]] size_type writable(const size_type tail, const size_type n) noexcept
+        {
+            if(capacity() - (tail - cached_head_) < n)
+                cached_head_ = head_.load(std::memory_order_acquire);
+            return std::min(n, capacity() - (tail - cached_head_));
+        }
+
+        [[nodiscard]] size_type readable(const size_type head, const size_type n) noexcept
+        {
+            if(cached_tail_ - head < n) cached_tail_ = tail_.load(std::memory_order_acquire);
+            return std::min(n, cached_tail_ - head);
+        }
+
+        // the index range [index, index + count) split at the end of the ring
+        [[nodiscard]] auto segments(const size_type index, const size_type count) const noexcept
+        {
+            const auto offset = index & mask_;
+            const auto first = std::min(count, capacity() - offset);
+            return std::pair{data_ + offset, first}; // NOLINT(*-pointer-arithmetic)
+        }
+
+    public:
+        explicit spsc_queue(const size_type capacity, const Allocator& alloc = Allocator{}):
+            mask_(std::bit_ceil(capacity) - 1),
+            alloc_(alloc),
+            data_(alloc_traits::allocate(alloc_, mask_ + 1))
+        {
+            Expects(capacity > 0);
+
+            size_type i = 0;
+            try
+            {
+                for(; i <= mask_; ++i) alloc_traits::construct(alloc_, data_ + i); // NOLINT
+            }
+            catch(...)
+            {
+                std::ranges::destroy_n(data_, i);
+                alloc_traits::deallocate(alloc_, data_, mask_ + 1);
+                throw;
+            }
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue(spsc_queue&&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+        spsc_queue& operator=(spsc_queue&&) = delete;
+
+        ~spsc_queue()
+        {
+            for(size_type i = 0; i <= mask_; ++i)
+                alloc_traits::destroy(alloc_, data_ + i); // NOLINT(*-pointer-arithmetic)
+            alloc_traits::deallocate(alloc_, data_, mask_ + 1);
+        }
+
+        // producer only
+        template<typename... Args>
+            requires std::assignable_from<T&, T> && std::constructible_from<T, Args...>
+        [[nodiscard]] bool try_emplace_back(Args&&... args)
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+
+            if(writable(tail, 1) == 0) return false;
+
+            data_[tail & mask_] = T(cpp_forward(args)...); // NOLINT(*-pointer-arithmetic)
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // producer only, moves up to n elements in and publishes them at once
+        template<std::input_iterator In>
+            requires std::indirectly_movable<In, T*>
+        batch_result<In> push_n(In in, const size_type n)
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            const auto count = writable(tail, n);
+            const auto [ptr, first] = segments(tail, count);
+
+            using diff_t = std::iter_difference_t<In>;
+
+            in = move_n(cpp_move(in), static_cast<diff_t>(first), ptr).in;
+            in = move_n(cpp_move(in), static_cast<diff_t>(count - first), data_).in;
+
+            tail_.store(tail + count, std::memory_order_release);
+            return {cpp_move(in), count};
+        }
+
+        // consumer only
+        [[nodiscard]] std::optional<T> try_pop_front()
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+
+            if(readable(head, 1) == 0) return std::nullopt;
+
+            std::optional<T> res{cpp_move(data_[head & mask_])}; // NOLINT(*-pointer-arithmetic)
+            head_.store(head + 1, std::memory_order_release);
+            return res;
+        }
+
+        // consumer only, moves up to n elements out and releases their slots at once
+        template<std::weakly_incrementable Out>
+            requires std::indirectly_movable<T*, Out>
+        batch_result<Out> pop_n(Out out, const size_type n)
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            const auto count = readable(head, n);
+            const auto [ptr, first] = segments(head, count);
+
+            using diff_t = std::ptrdiff_t;
+
+            out = move_n(ptr, static_cast<diff_t>(first), cpp_move(out)).out;
+            out = move_n(data_, static_cast<diff_t>(count - first), cpp_move(out)).out;
+
+            head_.store(head + count, std::memory_order_release);
+            return {cpp_move(out), count};
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return mask_ + 1; }
+
+        // exact only when called from the producer or the consumer thread
+        [[nodiscard]] size_type size() const noexcept
+        {
+            const auto head = head_.load(std::memory_order_acquire);
+            return tail_.load(std::memory_order_acquire) - head;
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept { return alloc_; }
+    };
+}
+
+#include "../compilation_config_out.h"
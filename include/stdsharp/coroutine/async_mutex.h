@@ -0,0 +1,208 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../macros.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace stdsharp
+{
+    template<typename Mutex>
+    class async_unique_lock
+    {
+        Mutex* mutex_ = nullptr;
+
+    public:
+        async_unique_lock() = default;
+
+        constexpr async_unique_lock(Mutex& mutex, const std::adopt_lock_t /*unused*/) noexcept:
+            mutex_(&mutex)
+        {
+        }
+
+        async_unique_lock(const async_unique_lock&) = delete;
+        async_unique_lock& operator=(const async_unique_lock&) = delete;
+
+        constexpr async_unique_lock(async_unique_lock&& other) noexcept:
+            mutex_(std::exchange(other.mutex_, nullptr))
+        {
+        }
+
+        constexpr async_unique_lock& operator=(async_unique_lock&& other) noexcept
+        {
+            if(this != &other)
+            {
+                if(owns_lock()) unlock();
+                mutex_ = std::exchange(other.mutex_, nullptr);
+            }
+            return *this;
+        }
+
+        constexpr ~async_unique_lock()
+        {
+            if(owns_lock()) unlock();
+        }
+
+        constexpr void unlock()
+        {
+            Expects(owns_lock());
+            std::exchange(mutex_, nullptr)->unlock();
+        }
+
+        [[nodiscard]] constexpr bool owns_lock() const noexcept { return mutex_ != nullptr; }
+
+        [[nodiscard]] constexpr Mutex* mutex() const noexcept { return mutex_; }
+    };
+
+    // lock-free mutex whose waiters are suspended coroutines, the waiters are pushed onto a
+    // lock-free stack and moved into an intrusive FIFO owned by the lock holder on unlock
+    class async_mutex
+    {
+        class lock_awaiter
+        {
+            friend class async_mutex;
+
+        protected:
+            async_mutex& mutex_; // NOLINT(*-non-private-member-variables-in-classes)
+
+        private:
+            lock_awaiter* next_ = nullptr;
+            std::coroutine_handle<> handle_;
+
+        public:
+            explicit lock_awaiter(async_mutex& mutex) noexcept: mutex_(mutex) {}
+
+            [[nodiscard]] bool await_ready() const noexcept { return mutex_.try_lock(); }
+
+            bool await_suspend(const std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                return mutex_.enqueue(*this);
+            }
+
+            static constexpr void await_resume() noexcept {}
+        };
+
+        class scoped_lock_awaiter : public lock_awaiter
+        {
+        public:
+            using lock_awaiter::lock_awaiter;
+
+            [[nodiscard]] async_unique_lock<async_mutex> await_resume() const noexcept
+            {
+                return {mutex_, std::adopt_lock};
+            }
+        };
+
+        static constexpr std::uintptr_t locked_no_waiters = 0;
+
+        [[nodiscard]] std::uintptr_t not_locked() const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(this); // NOLINT(*-reinterpret-cast)
+        }
+
+        // not_locked, locked_no_waiters, or the top of the waiter stack
+        std::atomic_uintptr_t state_{not_locked()};
+        lock_awaiter* waiters_ = nullptr;
+
+        bool enqueue(lock_awaiter& awaiter) noexcept
+        {
+            auto old = state_.load(std::memory_order_acquire);
+
+            while(true)
+                if(old == not_locked())
+                {
+                    if(state_.compare_exchange_weak(
+                           old,
+                           locked_no_waiters,
+                           std::memory_order_acquire,
+                           std::memory_order_relaxed
+                       ))
+                        return false;
+                }
+                else
+                {
+                    awaiter.next_ = reinterpret_cast<lock_awaiter*>(old); // NOLINT
+                    if(state_.compare_exchange_weak(
+                           old,
+                           reinterpret_cast<std::uintptr_t>(&awaiter), // NOLINT
+                           std::memory_order_release,
+                           std::memory_order_relaxed
+                       ))
+                        return true;
+                }
+        }
+
+    public:
+        async_mutex() = default;
+        async_mutex(const async_mutex&) = delete;
+        async_mutex(async_mutex&&) = delete;
+        async_mutex& operator=(const async_mutex&) = delete;
+        async_mutex& operator=(async_mutex&&) = delete;
+
+        ~async_mutex()
+        {
+            [[maybe_unused]] const auto state = state_.load(std::memory_order_relaxed);
+            Expects(state == not_locked() || state == locked_no_waiters);
+            Expects(waiters_ == nullptr);
+        }
+
+        [[nodiscard]] bool try_lock() noexcept
+        {
+            auto expected = not_locked();
+            return state_.compare_exchange_strong(
+                expected,
+                locked_no_waiters,
+                std::memory_order_acquire,
+                std::memory_order_relaxed
+            );
+        }
+
+        // co_await lock() acquires the mutex, which then must be released by unlock()
+        [[nodiscard]] lock_awaiter lock() noexcept { return lock_awaiter{*this}; }
+
+        // co_await scoped_lock() acquires the mutex and returns an async_unique_lock owning it
+        [[nodiscard]] scoped_lock_awaiter scoped_lock() noexcept
+        {
+            return scoped_lock_awaiter{*this};
+        }
+
+        // the next waiter, if any, is resumed inline on the calling thread
+        void unlock()
+        {
+            Expects(state_.load(std::memory_order_relaxed) != not_locked());
+
+            auto* head = waiters_;
+
+            if(head == nullptr)
+            {
+                auto old = locked_no_waiters;
+                if(state_.compare_exchange_strong(
+                       old,
+                       not_locked(),
+                       std::memory_order_release,
+                       std::memory_order_relaxed
+                   ))
+                    return;
+
+                old = state_.exchange(locked_no_waiters, std::memory_order_acquire);
+
+                // reverse the stack into FIFO order
+                for(auto* next = reinterpret_cast<lock_awaiter*>(old); next != nullptr;) // NOLINT
+                {
+                    auto* const temp = next->next_;
+                    next->next_ = head;
+                    head = next;
+                    next = temp;
+                }
+            }
+
+            waiters_ = head->next_;
+            head->handle_.resume();
+        }
+    };
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "async_mutex.h"
+
+namespace stdsharp
+{
+    template<typename Mutex>
+    class async_shared_lock
+    {
+        Mutex* mutex_ = nullptr;
+
+    public:
+        async_shared_lock() = default;
+
+        constexpr async_shared_lock(Mutex& mutex, const std::adopt_lock_t /*unused*/) noexcept:
+            mutex_(&mutex)
+        {
+        }
+
+        async_shared_lock(const async_shared_lock&) = delete;
+        async_shared_lock& operator=(const async_shared_lock&) = delete;
+
+        constexpr async_shared_lock(async_shared_lock&& other) noexcept:
+            mutex_(std::exchange(other.mutex_, nullptr))
+        {
+        }
+
+        constexpr async_shared_lock& operator=(async_shared_lock&& other) noexcept
+        {
+            if(this != &other)
+            {
+                if(owns_lock()) unlock();
+                mutex_ = std::exchange(other.mutex_, nullptr);
+            }
+            return *this;
+        }
+
+        constexpr ~async_shared_lock()
+        {
+            if(owns_lock()) unlock();
+        }
+
+        constexpr void unlock()
+        {
+            Expects(owns_lock());
+            std::exchange(mutex_, nullptr)->unlock_shared();
+        }
+
+        [[nodiscard]] constexpr bool owns_lock() const noexcept { return mutex_ != nullptr; }
+
+        [[nodiscard]] constexpr Mutex* mutex() const noexcept { return mutex_; }
+    };
+
+    // reader-writer mutex whose waiters are suspended coroutines queued in an intrusive FIFO,
+    // a waiting writer blocks later readers so that writers can't starve
+    class async_shared_mutex
+    {
+        class awaiter_base
+        {
+            friend class async_shared_mutex;
+
+        protected:
+            async_shared_mutex& mutex_; // NOLINT(*-non-private-member-variables-in-classes)
+
+        private:
+            awaiter_base* next_ = nullptr;
+            std::coroutine_handle<> handle_;
+            bool shared_;
+
+        public:
+            awaiter_base(async_shared_mutex& mutex, const bool shared) noexcept:
+                mutex_(mutex), shared_(shared)
+            {
+            }
+
+            [[nodiscard]] bool await_ready() const noexcept
+            {
+                return shared_ ? mutex_.try_lock_shared() : mutex_.try_lock();
+            }
+
+            bool await_suspend(const std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                return mutex_.enqueue(*this);
+            }
+
+            static constexpr void await_resume() noexcept {}
+        };
+
+        struct lock_awaiter : awaiter_base
+        {
+            explicit lock_awaiter(async_shared_mutex& mutex) noexcept: awaiter_base(mutex, false)
+            {
+            }
+        };
+
+        struct lock_shared_awaiter : awaiter_base
+        {
+            explicit lock_shared_awaiter(async_shared_mutex& mutex) noexcept:
+                awaiter_base(mutex, true)
+            {
+            }
+        };
+
+        struct scoped_lock_awaiter : lock_awaiter
+        {
+            using lock_awaiter::lock_awaiter;
+
+            [[nodiscard]] async_unique_lock<async_shared_mutex> await_resume() const noexcept
+            {
+                return {mutex_, std::adopt_lock};
+            }
+        };
+
+        struct scoped_lock_shared_awaiter : lock_shared_awaiter
+        {
+            using lock_shared_awaiter::lock_shared_awaiter;
+
+            [[nodiscard]] async_shared_lock<async_shared_mutex> await_resume() const noexcept
+            {
+                return {mutex_, std::adopt_lock};
+            }
+        };
+
+        std::mutex guard_;
+        std::size_t readers_ = 0;
+        bool writer_ = false;
+        awaiter_base* head_ = nullptr;
+        awaiter_base* tail_ = nullptr;
+
+        [[nodiscard]] bool acquire(const bool shared) noexcept
+        {
+            if(writer_) return false;
+
+            if(shared)
+            {
+                if(head_ != nullptr) return false;
+                ++readers_;
+            }
+            else
+            {
+                if(readers_ != 0) return false;
+                writer_ = true;
+            }
+
+            return true;
+        }
+
+        bool enqueue(awaiter_base& awaiter) noexcept
+        {
+            const std::lock_guard lock{guard_};
+
+            if(acquire(awaiter.shared_)) return false;
+
+            if(tail_ == nullptr) head_ = &awaiter;
+            else tail_->next_ = &awaiter;
+            tail_ = &awaiter;
+
+            return true;
+        }
+
+        // pops either the first writer or all the leading readers and grants them the lock
+        [[nodiscard]] awaiter_base* pop_ready() noexcept
+        {
+            auto* const first = head_;
+
+            if(first == nullptr) return nullptr;
+
+            auto* last = first;
+
+            if(first->shared_)
+            {
+                ++readers_;
+                while(last->next_ != nullptr && last->next_->shared_)
+                {
+                    last = last->next_;
+                    ++readers_;
+                }
+            }
+            else writer_ = true;
+
+            head_ = last->next_;
+            if(head_ == nullptr) tail_ = nullptr;
+            last->next_ = nullptr;
+
+            return first;
+        }
+
+        static void resume_all(awaiter_base* awaiter)
+        {
+            while(awaiter != nullptr)
+                std::exchange(awaiter, awaiter->next_)->handle_.resume();
+        }
+
+    public:
+        async_shared_mutex() = default;
+        async_shared_mutex(const async_shared_mutex&) = delete;
+        async_shared_mutex(async_shared_mutex&&) = delete;
+        async_shared_mutex& operator=(const async_shared_mutex&) = delete;
+        async_shared_mutex& operator=(async_shared_mutex&&) = delete;
+
+        ~async_shared_mutex()
+        {
+            Expects(!writer_);
+            Expects(readers_ == 0);
+            Expects(head_ == nullptr);
+        }
+
+        [[nodiscard]] bool try_lock() noexcept
+        {
+            const std::lock_guard lock{guard_};
+            return acquire(false);
+        }
+
+        [[nodiscard]] bool try_lock_shared() noexcept
+        {
+            const std::lock_guard lock{guard_};
+            return acquire(true);
+        }
+
+        [[nodiscard]] lock_awaiter lock() noexcept { return lock_awaiter{*this}; }
+
+        [[nodiscard]] lock_shared_awaiter lock_shared() noexcept
+        {
+            return lock_shared_awaiter{*this};
+        }
+
+        [[nodiscard]] scoped_lock_awaiter scoped_lock() noexcept
+        {
+            return scoped_lock_awaiter{*this};
+        }
+
+        [[nodiscard]] scoped_lock_shared_awaiter scoped_lock_shared() noexcept
+        {
+            return scoped_lock_shared_awaiter{*this};
+        }
+
+        // the granted waiters are resumed inline on the calling thread
+        void unlock()
+        {
+            awaiter_base* ready = nullptr;
+            {
+                const std::lock_guard lock{guard_};
+                Expects(writer_);
+                writer_ = false;
+                ready = pop_ready();
+            }
+            resume_all(ready);
+        }
+
+        void unlock_shared()
+        {
+            awaiter_base* ready = nullptr;
+            {
+                const std::lock_guard lock{guard_};
+                Expects(readers_ != 0);
+                if(--readers_ == 0) ready = pop_ready();
+            }
+            resume_all(ready);
+        }
+    };
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "async_shared_mutex.h"
+
+namespace stdsharp
+{
+    template<typename T>
+    concept async_shared_lockable = requires(T& t) {
+        t.scoped_lock().await_resume();
+        t.scoped_lock_shared().await_resume();
+    };
+
+    // coroutine counterpart of synchronizer, co_await read_with(value)/write_with(value) suspends
+    // until the lock is acquired and then returns the value together with the lock
+    template<async_shared_lockable Lockable = async_shared_mutex>
+    class async_synchronizer
+    {
+    public:
+        using lock_type = Lockable;
+
+    private:
+        template<typename Awaiter, typename T>
+        class with_awaiter
+        {
+            Awaiter awaiter_;
+            T value_;
+
+            using lock_t = decltype(std::declval<Awaiter&>().await_resume());
+
+        public:
+            struct local
+            {
+                T value;
+                lock_t lock;
+            };
+
+            constexpr with_awaiter(Awaiter awaiter, T value) noexcept:
+                awaiter_(cpp_move(awaiter)), value_(static_cast<T>(value))
+            {
+            }
+
+            [[nodiscard]] bool await_ready() noexcept { return awaiter_.await_ready(); }
+
+            auto await_suspend(const std::coroutine_handle<> handle) noexcept
+            {
+                return awaiter_.await_suspend(handle);
+            }
+
+            [[nodiscard]] local await_resume() noexcept
+            {
+                return {.value = static_cast<T>(value_), .lock = awaiter_.await_resume()};
+            }
+        };
+
+        template<typename Awaiter, typename T>
+        static constexpr auto make_with(Awaiter awaiter, T&& value) noexcept
+        {
+            return with_awaiter<Awaiter, T&&>{cpp_move(awaiter), cpp_forward(value)};
+        }
+
+    public:
+        async_synchronizer() = default;
+
+        async_synchronizer(const async_synchronizer&) = delete;
+        async_synchronizer(async_synchronizer&&) = delete;
+        async_synchronizer& operator=(const async_synchronizer&) = delete;
+        async_synchronizer& operator=(async_synchronizer&&) = delete;
+        ~async_synchronizer() = default;
+
+        template<typename T>
+        [[nodiscard]] constexpr auto read_with(const T& value) const noexcept
+        {
+            return make_with(lockable_.scoped_lock_shared(), value);
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr auto read_with(const T&& value) const noexcept
+        {
+            return make_with(lockable_.scoped_lock_shared(), cpp_move(value));
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr auto write_with(T&& value) const noexcept
+        {
+            return make_with(lockable_.scoped_lock(), cpp_forward(value));
+        }
+
+        constexpr const lock_type& lockable() const noexcept { return lockable_; }
+
+    protected:
+        mutable lock_type lockable_{};
+    };
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "async_mutex.h" // IWYU pragma: export
+#include "async_shared_mutex.h" // IWYU pragma: export
+#include "async_synchronizer.h" // IWYU pragma: export
+#include "generator.h" // IWYU pragma: export
+#include "promise_allocator.h" // IWYU pragma: export
+#include "schedule.h" // IWYU pragma: export
+#include "task.h" // IWYU pragma: export
+#include "when_all.h" // IWYU pragma: export
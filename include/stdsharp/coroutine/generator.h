@@ -0,0 +1,241 @@
+#pragma once
+
+#include "promise_allocator.h"
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <ranges>
+
+namespace stdsharp
+{
+    template<typename R>
+    struct elements_of
+    {
+        R range; // NOLINT(*-avoid-const-or-ref-data-members)
+    };
+
+    template<typename R>
+    elements_of(R&&) -> elements_of<R&&>;
+
+    // coroutine producing a sequence of values on demand, nested generators yielded through
+    // elements_of are resumed directly from the iterator instead of through every enclosing level
+    template<typename T>
+    class generator : public std::ranges::view_interface<generator<T>>
+    {
+    public:
+        using value_type = std::remove_cvref_t<T>;
+        using reference = std::conditional_t<std::is_reference_v<T>, T, T&&>;
+
+        class promise_type;
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+        using pointer = std::add_pointer_t<reference>;
+
+        handle_type handle_;
+
+        explicit generator(const handle_type handle) noexcept: handle_(handle) {}
+
+        // a generator that yields the elements of a range which isn't this generator type, the
+        // range outlives it since both are alive until the end of the co_yield expression
+        template<typename R>
+        static generator from_range(R&& range)
+        {
+            for(auto&& element : range) co_yield cpp_forward(element);
+        }
+
+    public:
+        class promise_type : public promise_allocator
+        {
+            friend class generator;
+
+            pointer value_ = nullptr;
+            promise_type* root_ = this;
+            promise_type* leaf_ = this; // active generator, only maintained by the root
+            promise_type* parent_ = nullptr;
+            std::exception_ptr exception_;
+
+            [[nodiscard]] handle_type handle() noexcept { return handle_type::from_promise(*this); }
+
+            struct final_awaiter
+            {
+                [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+                static std::coroutine_handle<> await_suspend(const handle_type handle) noexcept
+                {
+                    auto& promise = handle.promise();
+                    auto* const parent = promise.parent_;
+
+                    if(parent == nullptr) return std::noop_coroutine();
+
+                    promise.root_->leaf_ = parent;
+                    return parent->handle();
+                }
+
+                static constexpr void await_resume() noexcept {}
+            };
+
+            struct copy_awaiter : std::suspend_always
+            {
+                value_type value;
+                promise_type* root;
+
+                void await_suspend(const std::coroutine_handle<> /*unused*/) noexcept
+                {
+                    root->value_ = std::addressof(value);
+                }
+            };
+
+            class nested_awaiter
+            {
+                generator gen_;
+                promise_type& parent_;
+
+            public:
+                nested_awaiter(generator gen, promise_type& parent) noexcept:
+                    gen_(cpp_move(gen)), parent_(parent)
+                {
+                }
+
+                [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(const std::coroutine_handle<> /*unused*/
+                ) const noexcept
+                {
+                    auto& nested = gen_.handle_.promise();
+                    nested.root_ = parent_.root_;
+                    nested.parent_ = &parent_;
+                    parent_.root_->leaf_ = &nested;
+                    return gen_.handle_;
+                }
+
+                void await_resume() const
+                {
+                    if(auto& exception = gen_.handle_.promise().exception_; exception)
+                        std::rethrow_exception(exception);
+                }
+            };
+
+        public:
+            generator get_return_object() noexcept { return generator{handle()}; }
+
+            static constexpr std::suspend_always initial_suspend() noexcept { return {}; }
+
+            static constexpr final_awaiter final_suspend() noexcept { return {}; }
+
+            std::suspend_always yield_value(reference value) noexcept
+            {
+                root_->value_ = std::addressof(value);
+                return {};
+            }
+
+            copy_awaiter yield_value(const value_type& value)
+                noexcept(nothrow_copy_constructible<value_type>)
+                requires std::is_rvalue_reference_v<reference> &&
+                std::copy_constructible<value_type>
+            {
+                return {{}, value, root_};
+            }
+
+            template<typename R>
+                requires std::same_as<R, generator> || std::same_as<R, generator&&>
+            nested_awaiter yield_value(elements_of<R> elements) noexcept
+            {
+                return {cpp_move(elements.range), *this};
+            }
+
+            template<std::ranges::input_range R>
+                requires(!std::same_as<std::remove_cvref_t<R>, generator>) &&
+                (std::convertible_to<std::ranges::range_reference_t<R>, reference> ||
+                 std::convertible_to<std::ranges::range_reference_t<R>, const value_type&>)
+            nested_awaiter yield_value(elements_of<R> elements)
+            {
+                return {from_range(cpp_forward(elements.range)), *this};
+            }
+
+            static constexpr void return_void() noexcept {}
+
+            void unhandled_exception()
+            {
+                if(parent_ == nullptr) throw;
+                exception_ = std::current_exception();
+            }
+
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        class iterator
+        {
+            friend class generator;
+
+            handle_type handle_;
+
+            explicit iterator(const handle_type handle) noexcept: handle_(handle) {}
+
+        public:
+            using value_type = generator::value_type;
+            using difference_type = std::ptrdiff_t;
+
+            iterator(iterator&& other) noexcept: handle_(std::exchange(other.handle_, {})) {}
+
+            iterator& operator=(iterator&& other) noexcept
+            {
+                handle_ = std::exchange(other.handle_, {});
+                return *this;
+            }
+
+            iterator(const iterator&) = delete;
+            iterator& operator=(const iterator&) = delete;
+            ~iterator() = default;
+
+            [[nodiscard]] reference operator*() const noexcept
+            {
+                Expects(!handle_.done());
+                return static_cast<reference>(*handle_.promise().value_);
+            }
+
+            iterator& operator++()
+            {
+                Expects(!handle_.done());
+                handle_.promise().leaf_->handle().resume();
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            [[nodiscard]] bool operator==(const std::default_sentinel_t /*unused*/) const noexcept
+            {
+                return handle_.done();
+            }
+        };
+
+        generator() = default;
+
+        generator(generator&& other) noexcept: handle_(std::exchange(other.handle_, {})) {}
+
+        generator& operator=(generator other) noexcept
+        {
+            std::ranges::swap(handle_, other.handle_);
+            return *this;
+        }
+
+        generator(const generator&) = delete;
+
+        ~generator()
+        {
+            if(handle_) handle_.destroy();
+        }
+
+        // can only be called once
+        [[nodiscard]] iterator begin()
+        {
+            Expects(handle_);
+            handle_.resume();
+            return iterator{handle_};
+        }
+
+        [[nodiscard]] static constexpr std::default_sentinel_t end() noexcept { return {}; }
+    };
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "../memory/allocator_traits.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace stdsharp::details
+{
+    struct alignas(std::max_align_t) coroutine_frame_block
+    {
+        std::array<std::byte, alignof(std::max_align_t)> data;
+    };
+
+    using coroutine_frame_deallocator = void (*)(void*, std::size_t) noexcept;
+
+    [[nodiscard]] constexpr std::size_t
+        align_frame_offset(const std::size_t size, const std::size_t alignment) noexcept
+    {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    // frame layout: [coroutine frame][deallocator][allocator], rounded up to whole blocks
+    template<typename Alloc>
+    struct coroutine_frame_layout
+    {
+        using block_allocator =
+            allocator_traits<Alloc>::template rebind_alloc<coroutine_frame_block>;
+        using block_traits = allocator_traits<block_allocator>;
+
+        static_assert(alignof(block_allocator) <= alignof(coroutine_frame_block));
+
+        std::size_t deallocator_offset;
+        std::size_t allocator_offset;
+        std::size_t block_count;
+
+        constexpr explicit coroutine_frame_layout(const std::size_t size) noexcept:
+            deallocator_offset(align_frame_offset(size, alignof(coroutine_frame_deallocator))),
+            allocator_offset(align_frame_offset(
+                deallocator_offset + sizeof(coroutine_frame_deallocator),
+                alignof(block_allocator)
+            )),
+            block_count(
+                align_frame_offset(
+                    allocator_offset + sizeof(block_allocator),
+                    sizeof(coroutine_frame_block)
+                ) /
+                sizeof(coroutine_frame_block)
+            )
+        {
+        }
+    };
+}
+
+namespace stdsharp
+{
+    // base of promise types whose coroutine frame can be allocated by a user-provided allocator,
+    // passed as the leading std::allocator_arg_t, Alloc pair of the coroutine parameters
+    class promise_allocator
+    {
+        template<typename Alloc>
+        static void deallocate(void* const ptr, const std::size_t size) noexcept
+        {
+            using layout = details::coroutine_frame_layout<Alloc>;
+            using block_allocator = layout::block_allocator;
+
+            const layout l{size};
+            auto* const bytes = static_cast<std::byte*>(ptr);
+            auto& stored = *std::launder(
+                reinterpret_cast<block_allocator*>(bytes + l.allocator_offset) // NOLINT
+            );
+            block_allocator alloc{cpp_move(stored)};
+
+            std::ranges::destroy_at(&stored);
+            layout::block_traits::deallocate(
+                alloc,
+                static_cast<details::coroutine_frame_block*>(ptr),
+                l.block_count
+            );
+        }
+
+        template<typename Alloc>
+        [[nodiscard]] static void* allocate(const Alloc& alloc, const std::size_t size)
+        {
+            using layout = details::coroutine_frame_layout<Alloc>;
+            using block_allocator = layout::block_allocator;
+
+            const layout l{size};
+            block_allocator block_alloc{alloc};
+            void* const ptr =
+                std::to_address(layout::block_traits::allocate(block_alloc, l.block_count));
+            auto* const bytes = static_cast<std::byte*>(ptr);
+
+            ::new(bytes + l.deallocator_offset)
+                details::coroutine_frame_deallocator{&deallocate<Alloc>};
+            ::new(bytes + l.allocator_offset) block_allocator{cpp_move(block_alloc)};
+
+            return ptr;
+        }
+
+    public:
+        [[nodiscard]] static void* operator new(const std::size_t size)
+        {
+            return allocate(std::allocator<std::byte>{}, size);
+        }
+
+        template<allocator_req Alloc, typename... Args>
+        [[nodiscard]] static void* operator new(
+            const std::size_t size,
+            const std::allocator_arg_t /*unused*/,
+            const Alloc& alloc,
+            const Args&... /*unused*/
+        )
+        {
+            return allocate(alloc, size);
+        }
+
+        template<typename This, allocator_req Alloc, typename... Args>
+        [[nodiscard]] static void* operator new(
+            const std::size_t size,
+            const This& /*unused*/,
+            const std::allocator_arg_t /*unused*/,
+            const Alloc& alloc,
+            const Args&... /*unused*/
+        )
+        {
+            return allocate(alloc, size);
+        }
+
+        static void operator delete(void* const ptr, const std::size_t size) noexcept
+        {
+            const auto offset =
+                details::align_frame_offset(size, alignof(details::coroutine_frame_deallocator));
+            const auto deallocator = *std::launder(
+                reinterpret_cast<details::coroutine_frame_deallocator*>( // NOLINT
+                    static_cast<std::byte*>(ptr) + offset
+                )
+            );
+
+            deallocator(ptr, size);
+        }
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "task.h"
+
+#include "../functional/invoke.h"
+
+namespace stdsharp::details
+{
+    struct resume_handle
+    {
+        std::coroutine_handle<> handle;
+
+        void operator()() const { handle.resume(); }
+    };
+
+    template<typename Executor>
+    class schedule_awaiter
+    {
+        Executor executor_;
+
+    public:
+        template<typename... Args>
+        explicit constexpr schedule_awaiter(Args&&... args): executor_(cpp_forward(args)...)
+        {
+        }
+
+        [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+        void await_suspend(const std::coroutine_handle<> handle)
+        {
+            invoke(executor_, resume_handle{handle});
+        }
+
+        static constexpr void await_resume() noexcept {}
+    };
+}
+
+namespace stdsharp
+{
+    // suspends the awaiting coroutine and resumes it on the executor, an executor is any invocable
+    // accepting a nullary invocable, e.g. thread_pool
+    inline constexpr struct schedule_on_fn
+    {
+        template<typename Executor>
+            requires std::invocable<Executor&, details::resume_handle>
+        constexpr auto operator()(Executor& executor) const noexcept
+        {
+            return details::schedule_awaiter<Executor&>{executor};
+        }
+
+        template<typename Executor>
+            requires std::invocable<Executor&, details::resume_handle> &&
+            (!std::is_lvalue_reference_v<Executor>)
+        constexpr auto operator()(Executor&& executor) const
+        {
+            return details::schedule_awaiter<std::decay_t<Executor>>{cpp_forward(executor)};
+        }
+    } schedule_on{};
+
+    // starts the task on the executor, the awaiting coroutine is resumed on the thread where the
+    // task completes
+    inline constexpr struct start_on_fn
+    {
+        template<typename Executor, typename T>
+            requires std::invocable<Executor&, details::resume_handle>
+        task<T> operator()(Executor& executor, task<T> t) const
+        {
+            co_await schedule_on(executor);
+            co_return co_await cpp_move(t);
+        }
+    } start_on{};
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#include "promise_allocator.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <variant>
+
+namespace stdsharp::details
+{
+    template<typename T>
+    class task_promise_result
+    {
+        using stored_t = std::conditional_t<std::is_reference_v<T>, std::add_pointer_t<T>, T>;
+
+        std::variant<std::monostate, stored_t, std::exception_ptr> result_;
+
+    public:
+        template<typename U = T>
+            requires std::convertible_to<U, T>
+        void return_value(U&& value)
+        {
+            if constexpr(std::is_reference_v<T>)
+            {
+                T ref = cpp_forward(value);
+                result_.template emplace<1>(std::addressof(ref));
+            }
+            else result_.template emplace<1>(cpp_forward(value));
+        }
+
+        void unhandled_exception() noexcept
+        {
+            result_.template emplace<2>(std::current_exception());
+        }
+
+        template<typename Self>
+        decltype(auto) result(this Self&& self)
+        {
+            auto& r = self.result_;
+
+            if(r.index() == 2) std::rethrow_exception(std::get<2>(r));
+
+            if constexpr(std::is_reference_v<T>) return static_cast<T>(*std::get<1>(r));
+            else return std::get<1>(forward_cast<Self, task_promise_result>(self).result_);
+        }
+    };
+
+    template<>
+    class task_promise_result<void>
+    {
+        std::exception_ptr exception_;
+
+    public:
+        void return_void() const noexcept {}
+
+        void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+        void result() const
+        {
+            if(exception_) std::rethrow_exception(exception_);
+        }
+    };
+}
+
+namespace stdsharp
+{
+    template<typename T = void>
+    class [[nodiscard]] task
+    {
+    public:
+        using value_type = T;
+
+        class promise_type : public promise_allocator, public details::task_promise_result<T>
+        {
+            friend class task;
+
+            std::coroutine_handle<> continuation_ = std::noop_coroutine();
+
+            struct final_awaiter
+            {
+                [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+                static std::coroutine_handle<>
+                    await_suspend(const std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    return handle.promise().continuation_;
+                }
+
+                static constexpr void await_resume() noexcept {}
+            };
+
+        public:
+            task get_return_object() noexcept
+            {
+                return task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            static constexpr std::suspend_always initial_suspend() noexcept { return {}; }
+
+            static constexpr final_awaiter final_suspend() noexcept { return {}; }
+        };
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        handle_type handle_;
+
+        explicit task(const handle_type handle) noexcept: handle_(handle) {}
+
+        struct awaiter_base
+        {
+            handle_type handle;
+
+            [[nodiscard]] bool await_ready() const noexcept { return handle.done(); }
+
+            std::coroutine_handle<>
+                await_suspend(const std::coroutine_handle<> awaiting) const noexcept
+            {
+                handle.promise().continuation_ = awaiting;
+                return handle;
+            }
+        };
+
+        struct lvalue_awaiter : awaiter_base
+        {
+            decltype(auto) await_resume() const { return this->handle.promise().result(); }
+        };
+
+        struct rvalue_awaiter : awaiter_base
+        {
+            T await_resume() const { return cpp_move(this->handle.promise()).result(); }
+        };
+
+        struct ready_awaiter : awaiter_base
+        {
+            static constexpr void await_resume() noexcept {}
+        };
+
+    public:
+        task() = default;
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        task(task&& other) noexcept: handle_(std::exchange(other.handle_, {})) {}
+
+        task& operator=(task&& other) noexcept
+        {
+            if(this != &other)
+            {
+                if(handle_) handle_.destroy();
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+
+        ~task()
+        {
+            if(handle_) handle_.destroy();
+        }
+
+        [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+        [[nodiscard]] bool done() const noexcept
+        {
+            Expects(valid());
+            return handle_.done();
+        }
+
+        auto operator co_await() & noexcept
+        {
+            Expects(valid());
+            return lvalue_awaiter{handle_};
+        }
+
+        auto operator co_await() && noexcept
+        {
+            Expects(valid());
+            return rvalue_awaiter{handle_};
+        }
+
+        // awaits the completion of the task without retrieving the result
+        [[nodiscard]] auto when_ready() const noexcept
+        {
+            Expects(valid());
+            return ready_awaiter{handle_};
+        }
+    };
+
+    namespace details
+    {
+        struct sync_wait_state
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool done = false;
+
+            void notify()
+            {
+                // notify while holding the lock, the waiter may destroy the state right after
+                const std::lock_guard lock{mutex};
+                done = true;
+                cv.notify_one();
+            }
+
+            void wait()
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [this] { return done; });
+            }
+        };
+
+        class sync_wait_task
+        {
+        public:
+            class promise_type
+            {
+                friend class sync_wait_task;
+
+                sync_wait_state* state_ = nullptr;
+
+                struct final_awaiter
+                {
+                    [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+                    static void
+                        await_suspend(const std::coroutine_handle<promise_type> handle) noexcept
+                    {
+                        handle.promise().state_->notify();
+                    }
+
+                    static constexpr void await_resume() noexcept {}
+                };
+
+            public:
+                sync_wait_task get_return_object() noexcept
+                {
+                    return sync_wait_task{std::coroutine_handle<promise_type>::from_promise(*this)
+                    };
+                }
+
+                static constexpr std::suspend_always initial_suspend() noexcept { return {}; }
+
+                static constexpr final_awaiter final_suspend() noexcept { return {}; }
+
+                static constexpr void return_void() noexcept {}
+
+                [[noreturn]] static void unhandled_exception() noexcept { std::terminate(); }
+            };
+
+        private:
+            std::coroutine_handle<promise_type> handle_;
+
+            explicit sync_wait_task(const std::coroutine_handle<promise_type> handle) noexcept:
+                handle_(handle)
+            {
+            }
+
+        public:
+            sync_wait_task(const sync_wait_task&) = delete;
+            sync_wait_task& operator=(const sync_wait_task&) = delete;
+            sync_wait_task(sync_wait_task&&) = delete;
+            sync_wait_task& operator=(sync_wait_task&&) = delete;
+
+            ~sync_wait_task() { handle_.destroy(); }
+
+            void run(sync_wait_state& state) const
+            {
+                handle_.promise().state_ = &state;
+                handle_.resume();
+                state.wait();
+            }
+        };
+
+        template<typename T>
+        sync_wait_task make_sync_wait_task(const task<T>& t)
+        {
+            co_await t.when_ready();
+        }
+    }
+
+    // blocks the calling thread until the task completes, possibly on another thread
+    inline constexpr struct sync_wait_fn
+    {
+        template<typename T>
+        T operator()(task<T>&& t) const
+        {
+            details::sync_wait_state state;
+
+            details::make_sync_wait_task(t).run(state);
+
+            return cpp_move(t).operator co_await().await_resume();
+        }
+    } sync_wait{};
+}
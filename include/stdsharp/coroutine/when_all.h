@@ -0,0 +1,301 @@
+#pragma once
+
+#include "task.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <tuple>
+
+namespace stdsharp::details
+{
+    template<typename T>
+    using when_all_value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    // the awaiting coroutine is resumed by whoever brings the counter to zero, which includes
+    // await_suspend itself so that children completing synchronously can't resume it early
+    struct when_all_counter
+    {
+        std::atomic_size_t count;
+        std::coroutine_handle<> awaiting;
+
+        explicit when_all_counter(const std::size_t n) noexcept: count(n + 1) {}
+
+        [[nodiscard]] bool arrive() noexcept
+        {
+            return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+    };
+
+    class when_all_starter
+    {
+    public:
+        class promise_type
+        {
+            friend class when_all_starter;
+
+            when_all_counter* counter_ = nullptr;
+
+            struct final_awaiter
+            {
+                [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+                static std::coroutine_handle<>
+                    await_suspend(const std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    auto& counter = *handle.promise().counter_;
+                    return counter.arrive() ? counter.awaiting : std::noop_coroutine();
+                }
+
+                static constexpr void await_resume() noexcept {}
+            };
+
+        public:
+            when_all_starter get_return_object() noexcept
+            {
+                return when_all_starter{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            static constexpr std::suspend_always initial_suspend() noexcept { return {}; }
+
+            static constexpr final_awaiter final_suspend() noexcept { return {}; }
+
+            static constexpr void return_void() noexcept {}
+
+            [[noreturn]] static void unhandled_exception() noexcept { std::terminate(); }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+        explicit when_all_starter(const std::coroutine_handle<promise_type> handle) noexcept:
+            handle_(handle)
+        {
+        }
+
+    public:
+        when_all_starter() = default;
+
+        when_all_starter(const when_all_starter&) = delete;
+        when_all_starter& operator=(const when_all_starter&) = delete;
+
+        when_all_starter(when_all_starter&& other) noexcept:
+            handle_(std::exchange(other.handle_, {}))
+        {
+        }
+
+        when_all_starter& operator=(when_all_starter&& other) noexcept
+        {
+            std::ranges::swap(handle_, other.handle_);
+            return *this;
+        }
+
+        ~when_all_starter()
+        {
+            if(handle_) handle_.destroy();
+        }
+
+        void start(when_all_counter& counter) const noexcept
+        {
+            handle_.promise().counter_ = &counter;
+            handle_.resume();
+        }
+    };
+
+    template<typename T>
+    when_all_starter make_when_all_starter(const task<T>& t)
+    {
+        co_await t.when_ready();
+    }
+
+    template<std::size_t N>
+    class when_all_awaiter
+    {
+        std::array<when_all_starter, N> starters_;
+        when_all_counter counter_{N};
+
+    public:
+        template<typename... T>
+        explicit when_all_awaiter(const task<T>&... tasks):
+            starters_{make_when_all_starter(tasks)...}
+        {
+        }
+
+        [[nodiscard]] static constexpr bool await_ready() noexcept { return N == 0; }
+
+        bool await_suspend(const std::coroutine_handle<> awaiting) noexcept
+        {
+            counter_.awaiting = awaiting;
+            for(const auto& starter : starters_) starter.start(counter_);
+            return !counter_.arrive();
+        }
+
+        static constexpr void await_resume() noexcept {}
+    };
+
+    template<typename T>
+    struct non_void_task_awaiter
+    {
+        decltype(std::declval<task<T>>().operator co_await()) awaiter;
+
+        [[nodiscard]] bool await_ready() const noexcept { return awaiter.await_ready(); }
+
+        auto await_suspend(const std::coroutine_handle<> awaiting) const noexcept
+        {
+            return awaiter.await_suspend(awaiting);
+        }
+
+        when_all_value_t<T> await_resume() const
+        {
+            if constexpr(std::is_void_v<T>)
+            {
+                awaiter.await_resume();
+                return {};
+            }
+            else return awaiter.await_resume();
+        }
+    };
+
+    template<typename T>
+    non_void_task_awaiter<T> non_void_await(task<T>&& t) noexcept
+    {
+        return {cpp_move(t).operator co_await()};
+    }
+
+    struct when_any_state_base
+    {
+        std::atomic_size_t resume_gate{2};
+        std::atomic_flag claimed;
+        std::size_t winner = 0;
+        std::coroutine_handle<> awaiting;
+
+        [[nodiscard]] bool arrive() noexcept
+        {
+            return resume_gate.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+    };
+
+    template<typename... T>
+    struct when_any_state : when_any_state_base
+    {
+        std::tuple<task<T>...> tasks;
+
+        explicit when_any_state(task<T>&&... t) noexcept: tasks(cpp_move(t)...) {}
+    };
+
+    // detached coroutine that keeps the shared state alive until its task completes, the frame
+    // destroys itself at the final suspension point
+    struct when_any_starter
+    {
+        struct promise_type
+        {
+            when_any_starter get_return_object() noexcept
+            {
+                return {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            static constexpr std::suspend_always initial_suspend() noexcept { return {}; }
+
+            static constexpr std::suspend_never final_suspend() noexcept { return {}; }
+
+            static constexpr void return_void() noexcept {}
+
+            [[noreturn]] static void unhandled_exception() noexcept { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    template<std::size_t I, typename State>
+    when_any_starter make_when_any_starter(const std::shared_ptr<State> state)
+    {
+        co_await std::get<I>(state->tasks).when_ready();
+
+        if(state->claimed.test_and_set(std::memory_order_acq_rel)) co_return;
+
+        state->winner = I;
+        if(state->arrive()) state->awaiting.resume();
+    }
+
+    template<typename... T>
+    class when_any_awaiter
+    {
+        using state_t = when_any_state<T...>;
+
+        std::shared_ptr<state_t> state_;
+
+    public:
+        explicit when_any_awaiter(std::shared_ptr<state_t> state) noexcept:
+            state_(cpp_move(state))
+        {
+        }
+
+        [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+        bool await_suspend(const std::coroutine_handle<> awaiting) const
+        {
+            state_->awaiting = awaiting;
+
+            [this]<std::size_t... I>(const std::index_sequence<I...>)
+            {
+                (make_when_any_starter<I>(state_).handle.resume(), ...);
+            }(std::index_sequence_for<T...>{});
+
+            return !state_->arrive();
+        }
+
+        [[nodiscard]] std::size_t await_resume() const noexcept { return state_->winner; }
+    };
+
+    template<std::size_t I, typename Variant, typename State>
+    task<Variant> when_any_result(std::shared_ptr<State> state)
+    {
+        co_return Variant{
+            std::in_place_index<I>,
+            co_await non_void_await(cpp_move(std::get<I>(state->tasks)))
+        };
+    }
+}
+
+namespace stdsharp
+{
+    // runs all the tasks concurrently and completes once every one of them has completed, void
+    // results are reported as std::monostate
+    inline constexpr struct when_all_fn
+    {
+        template<typename... T>
+        task<std::tuple<details::when_all_value_t<T>...>> operator()(task<T>... tasks) const
+        {
+            co_await details::when_all_awaiter<sizeof...(T)>{tasks...};
+
+            co_return std::tuple<details::when_all_value_t<T>...>{
+                co_await details::non_void_await(cpp_move(tasks))...
+            };
+        }
+    } when_all{};
+
+    // runs all the tasks concurrently and completes with the result of the first one that
+    // completes, the remaining tasks are kept alive until they complete on their own
+    inline constexpr struct when_any_fn
+    {
+        template<typename... T>
+            requires(sizeof...(T) > 0)
+        task<std::variant<details::when_all_value_t<T>...>> operator()(task<T>... tasks) const
+        {
+            using variant_t = std::variant<details::when_all_value_t<T>...>;
+            using state_t = details::when_any_state<T...>;
+
+            auto state = std::make_shared<state_t>(cpp_move(tasks)...);
+            const auto index = co_await details::when_any_awaiter<T...>{state};
+
+            co_return co_await [&]<std::size_t... I>(const std::index_sequence<I...>)
+            {
+                using fn_t = task<variant_t> (*)(std::shared_ptr<state_t>);
+                constexpr std::array<fn_t, sizeof...(T)> results{
+                    details::when_any_result<I, variant_t, state_t>...
+                };
+                return results[index](cpp_move(state)); // NOLINT(*-bounds-constant-array-index)
+            }(std::index_sequence_for<T...>{});
+        }
+    } when_any{};
+}
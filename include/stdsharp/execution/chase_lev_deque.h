@@ -0,0 +1,160 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../cstdint/cstdint.h"
+#include "../memory/aligned.h"
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace stdsharp
+{
+    // work-stealing deque from "Correct and Efficient Work-Stealing for Weak Memory Models",
+    // Lê et al. 2013. only the owner thread may push and pop, any thread may steal.
+    template<trivial_copyable T>
+    class chase_lev_deque
+    {
+        class ring
+        {
+            i64 mask_;
+            std::unique_ptr<std::atomic<T>[]> buffer_;
+
+        public:
+            explicit ring(const i64 capacity):
+                mask_(capacity - 1), buffer_(std::make_unique<std::atomic<T>[]>(capacity))
+            {
+                Expects(std::has_single_bit(make_unsigned(capacity)));
+            }
+
+            [[nodiscard]] i64 capacity() const noexcept { return mask_ + 1; }
+
+            [[nodiscard]] T load(const i64 i) const noexcept
+            {
+                return buffer_[i & mask_].load(std::memory_order_relaxed);
+            }
+
+            void store(const i64 i, const T value) noexcept
+            {
+                buffer_[i & mask_].store(value, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]] auto grow(const i64 top, const i64 bottom) const
+            {
+                auto res = std::make_unique<ring>(capacity() * 2);
+                for(auto i = top; i != bottom; ++i) res->store(i, load(i));
+                return res;
+            }
+        };
+
+        alignas(cache_line_size) std::atomic<i64> top_ = 0;
+        alignas(cache_line_size) std::atomic<i64> bottom_ = 0;
+        alignas(cache_line_size) std::atomic<ring*> ring_;
+
+        // thieves may still read from a replaced ring, so rings live as long as the deque
+        std::vector<std::unique_ptr<ring>> rings_;
+
+    public:
+        static constexpr i64 default_capacity = 256;
+
+        explicit chase_lev_deque(const i64 capacity = default_capacity)
+        {
+            rings_.emplace_back(std::make_unique<ring>(capacity));
+            ring_.store(rings_.back().get(), std::memory_order_relaxed);
+        }
+
+        chase_lev_deque(const chase_lev_deque&) = delete;
+        chase_lev_deque(chase_lev_deque&&) = delete;
+        chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+        chase_lev_deque& operator=(chase_lev_deque&&) = delete;
+        ~chase_lev_deque() = default;
+
+        void push(const T value)
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed);
+            const auto top = top_.load(std::memory_order_acquire);
+            auto* current = ring_.load(std::memory_order_relaxed);
+
+            if(bottom - top > current->capacity() - 1)
+            {
+                rings_.emplace_back(current->grow(top, bottom));
+                current = rings_.back().get();
+                ring_.store(current, std::memory_order_release);
+            }
+
+            current->store(bottom, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::optional<T> pop() noexcept
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            const auto* const current = ring_.load(std::memory_order_relaxed);
+
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto top = top_.load(std::memory_order_relaxed);
+
+            if(top > bottom)
+            {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            std::optional<T> res = current->load(bottom);
+
+            if(top == bottom)
+            {
+                if(!top_.compare_exchange_strong(
+                       top,
+                       top + 1,
+                       std::memory_order_seq_cst,
+                       std::memory_order_relaxed
+                   ))
+                    res.reset();
+
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return res;
+        }
+
+        [[nodiscard]] std::optional<T> steal() noexcept
+        {
+            auto top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = bottom_.load(std::memory_order_acquire);
+
+            if(top >= bottom) return std::nullopt;
+
+            const auto value = ring_.load(std::memory_order_acquire)->load(top);
+
+            if(!top_.compare_exchange_strong(
+                   top,
+                   top + 1,
+                   std::memory_order_seq_cst,
+                   std::memory_order_relaxed
+               ))
+                return std::nullopt;
+
+            return value;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return bottom_.load(std::memory_order_relaxed) <=
+                top_.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            const auto size =
+                bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+            return size > 0 ? static_cast<std::size_t>(size) : 0;
+        }
+    };
+}
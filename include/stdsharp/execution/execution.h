@@ -0,0 +1,5 @@
+#pragma once
+
+#include "chase_lev_deque.h" // IWYU pragma: export
+#include "parallel_policy.h" // IWYU pragma: export
+#include "thread_pool.h" // IWYU pragma: export
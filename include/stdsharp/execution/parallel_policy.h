@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../functional/invoke.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <latch>
+#include <thread>
+
+namespace stdsharp
+{
+    // splits index ranges into chunks and runs them on an executor, an executor is any invocable
+    // accepting a nullary invocable, e.g. thread_pool. the calling thread runs the first chunk and
+    // blocks until the rest finish, so it must not be a worker of a saturated executor.
+    template<typename Executor>
+    class parallel_policy
+    {
+        Executor* executor_;
+        std::size_t max_chunk_count_;
+        std::size_t min_chunk_size_;
+
+        template<typename Fn>
+        struct chunk_state
+        {
+            Fn& fn;
+            std::size_t size;
+            std::size_t count;
+            std::latch done;
+            std::exception_ptr exception{};
+            std::atomic_flag failed{};
+
+            void operator()(const std::size_t index) noexcept
+            {
+                try
+                {
+                    invoke(fn, size * index / count, size * (index + 1) / count, index);
+                }
+                catch(...)
+                {
+                    if(!failed.test_and_set(std::memory_order_relaxed))
+                        exception = std::current_exception();
+                }
+            }
+        };
+
+    public:
+        static constexpr std::size_t default_min_chunk_size = 4096;
+
+        explicit parallel_policy(
+            Executor& executor,
+            const std::size_t max_chunk_count = std::max(std::thread::hardware_concurrency(), 1U),
+            const std::size_t min_chunk_size = default_min_chunk_size
+        ):
+            executor_(&executor),
+            max_chunk_count_(max_chunk_count),
+            min_chunk_size_(min_chunk_size)
+        {
+            Expects(max_chunk_count_ > 0);
+            Expects(min_chunk_size_ > 0);
+        }
+
+        [[nodiscard]] constexpr Executor& executor() const noexcept { return *executor_; }
+
+        [[nodiscard]] constexpr std::size_t chunk_count(const std::size_t size) const noexcept
+        {
+            return std::max(
+                std::min(max_chunk_count_, (size + min_chunk_size_ - 1) / min_chunk_size_),
+                std::size_t{1}
+            );
+        }
+
+        // invokes fn(first, last, chunk_index) for each of the chunk_count(size) chunks of
+        // [0, size), rethrows the first exception after all chunks complete
+        template<std::invocable<std::size_t, std::size_t, std::size_t> Fn>
+        void for_each_chunk(const std::size_t size, Fn&& fn) const
+        {
+            const auto count = chunk_count(size);
+
+            if(count == 1)
+            {
+                invoke(fn, std::size_t{0}, size, std::size_t{0});
+                return;
+            }
+
+            chunk_state<Fn> state{
+                .fn = fn,
+                .size = size,
+                .count = count,
+                .done = std::latch{static_cast<std::ptrdiff_t>(count - 1)}
+            };
+
+            for(std::size_t i = 1; i < count; ++i)
+            {
+                const auto task = [&state, i]
+                {
+                    state(i);
+                    state.done.count_down();
+                };
+
+                // fall back to the calling thread if the executor fails to accept the task
+                try
+                {
+                    invoke(*executor_, task);
+                }
+                catch(...)
+                {
+                    task();
+                }
+            }
+
+            state(0);
+            state.done.wait();
+
+            if(state.exception) std::rethrow_exception(state.exception);
+        }
+    };
+}
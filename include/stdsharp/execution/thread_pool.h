@@ -0,0 +1,320 @@
+#pragma once
+
+#include "../functional/invoke.h"
+#include "../memory/soo.h"
+#include "chase_lev_deque.h"
+
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace stdsharp
+{
+    inline constexpr std::size_t default_task_soo_size = 4 * sizeof(void*);
+}
+
+namespace stdsharp::details
+{
+    template<std::size_t SooSize>
+    class thread_pool_task
+    {
+        static constexpr lifetime_req req{
+            .default_construct = expr_req::ill_formed,
+            .move_construct = expr_req::ill_formed,
+            .copy_construct = expr_req::ill_formed,
+            .move_assign = expr_req::ill_formed,
+            .copy_assign = expr_req::ill_formed
+        };
+
+        fixed_single_resource<SooSize> resource_{};
+        box<req, soo_allocator<SooSize>> fn_{make_soo_allocator(resource_)};
+        void (*invoke_)(thread_pool_task&) noexcept = nullptr;
+
+    public:
+        thread_pool_task* next = nullptr;
+
+        thread_pool_task() = default;
+        thread_pool_task(const thread_pool_task&) = delete;
+        thread_pool_task(thread_pool_task&&) = delete;
+        thread_pool_task& operator=(const thread_pool_task&) = delete;
+        thread_pool_task& operator=(thread_pool_task&&) = delete;
+        ~thread_pool_task() = default;
+
+        template<typename Fn, typename DecayFn = std::decay_t<Fn>>
+        void emplace(Fn&& fn)
+        {
+            fn_.template emplace<DecayFn>(cpp_forward(fn));
+            invoke_ = [](thread_pool_task& task) noexcept
+            {
+                invoke(task.fn_.template get<DecayFn>()); //
+            };
+        }
+
+        void operator()() noexcept
+        {
+            invoke_(*this);
+            fn_.reset();
+        }
+    };
+}
+
+namespace stdsharp
+{
+    template<std::size_t SooSize = default_task_soo_size>
+    class basic_thread_pool
+    {
+        using task = details::thread_pool_task<SooSize>;
+
+        static constexpr std::size_t cache_limit = 256;
+
+        struct worker
+        {
+            basic_thread_pool* pool;
+            chase_lev_deque<task*> deque{};
+            // tasks migrate between workers when stolen, but every worker only touches its own
+            // cache, so recycling a task never needs synchronization
+            std::vector<task*> cache{};
+        };
+
+        static inline thread_local worker* current_worker_ = nullptr;
+
+        std::vector<std::unique_ptr<worker>> workers_;
+
+        std::mutex injection_mutex_;
+        task* injection_head_ = nullptr;
+        task* injection_tail_ = nullptr;
+        task* free_tasks_ = nullptr;
+        std::atomic_size_t injected_ = 0;
+
+        std::atomic<u32> epoch_ = 0;
+        std::atomic<u32> sleeping_ = 0;
+        std::atomic_size_t pending_ = 0;
+        std::atomic<bool> stopping_ = false;
+
+        std::vector<std::jthread> threads_;
+
+        [[nodiscard]] worker* local_worker() const noexcept
+        {
+            auto* const w = current_worker_;
+            return w != nullptr && w->pool == this ? w : nullptr;
+        }
+
+        [[nodiscard]] task* acquire_task()
+        {
+            if(auto* const w = local_worker(); w != nullptr && !w->cache.empty())
+            {
+                auto* const t = w->cache.back();
+                w->cache.pop_back();
+                return t;
+            }
+
+            {
+                const std::lock_guard lock{injection_mutex_};
+
+                if(auto* const t = free_tasks_; t != nullptr)
+                {
+                    free_tasks_ = t->next;
+                    t->next = nullptr;
+                    return t;
+                }
+            }
+
+            return new task; // NOLINT(*-owning-memory)
+        }
+
+        void recycle(worker& w, task* const t)
+        {
+            if(w.cache.size() < cache_limit)
+            {
+                w.cache.push_back(t);
+                return;
+            }
+
+            const std::lock_guard lock{injection_mutex_};
+            t->next = free_tasks_;
+            free_tasks_ = t;
+        }
+
+        void inject(task* const t)
+        {
+            {
+                const std::lock_guard lock{injection_mutex_};
+
+                if(injection_tail_ == nullptr) injection_head_ = t;
+                else injection_tail_->next = t;
+
+                injection_tail_ = t;
+            }
+
+            injected_.fetch_add(1, std::memory_order_release);
+        }
+
+        [[nodiscard]] task* take_injected()
+        {
+            if(injected_.load(std::memory_order_acquire) == 0) return nullptr;
+
+            const std::lock_guard lock{injection_mutex_};
+            auto* const t = injection_head_;
+
+            if(t == nullptr) return nullptr;
+
+            injection_head_ = t->next;
+            if(injection_head_ == nullptr) injection_tail_ = nullptr;
+            t->next = nullptr;
+            injected_.fetch_sub(1, std::memory_order_relaxed);
+
+            return t;
+        }
+
+        [[nodiscard]] task* find_task(worker& w, const std::size_t index)
+        {
+            if(const auto t = w.deque.pop(); t) return *t;
+
+            if(auto* const t = take_injected(); t != nullptr) return t;
+
+            const auto size = workers_.size();
+
+            for(std::size_t i = 1; i < size; ++i)
+                if(const auto t = workers_[(index + i) % size]->deque.steal(); t) return *t;
+
+            return nullptr;
+        }
+
+        void notify() noexcept
+        {
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            if(sleeping_.load(std::memory_order_seq_cst) > 0) epoch_.notify_one();
+        }
+
+        void execute(worker& w, task* const t)
+        {
+            (*t)();
+            recycle(w, t);
+
+            if(pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) pending_.notify_all();
+        }
+
+        void run(const std::size_t index)
+        {
+            auto& w = *workers_[index];
+            current_worker_ = &w;
+
+            while(true)
+            {
+                if(auto* const t = find_task(w, index); t != nullptr)
+                {
+                    execute(w, t);
+                    continue;
+                }
+
+                sleeping_.fetch_add(1, std::memory_order_seq_cst);
+
+                const auto epoch = epoch_.load(std::memory_order_seq_cst);
+
+                if(auto* const t = find_task(w, index); t != nullptr)
+                {
+                    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                    execute(w, t);
+                    continue;
+                }
+
+                if(stopping_.load(std::memory_order_acquire))
+                {
+                    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                    break;
+                }
+
+                epoch_.wait(epoch, std::memory_order_seq_cst);
+                sleeping_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            current_worker_ = nullptr;
+        }
+
+        static void delete_list(task* t) noexcept
+        {
+            while(t != nullptr) delete std::exchange(t, t->next); // NOLINT(*-owning-memory)
+        }
+
+    public:
+        explicit basic_thread_pool(
+            const std::size_t size = std::max(std::thread::hardware_concurrency(), 1U)
+        )
+        {
+            Expects(size > 0);
+
+            workers_.reserve(size);
+            for(std::size_t i = 0; i < size; ++i)
+                workers_.emplace_back(std::make_unique<worker>(this));
+
+            threads_.reserve(size);
+            for(std::size_t i = 0; i < size; ++i) threads_.emplace_back([this, i] { run(i); });
+        }
+
+        basic_thread_pool(const basic_thread_pool&) = delete;
+        basic_thread_pool(basic_thread_pool&&) = delete;
+        basic_thread_pool& operator=(const basic_thread_pool&) = delete;
+        basic_thread_pool& operator=(basic_thread_pool&&) = delete;
+
+        ~basic_thread_pool()
+        {
+            stopping_.store(true, std::memory_order_release);
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            epoch_.notify_all();
+            threads_.clear();
+
+            for(const auto& w : workers_)
+                for(auto* const t : w->cache) delete t; // NOLINT(*-owning-memory)
+
+            delete_list(free_tasks_);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return workers_.size(); }
+
+        // queues fn to run on a worker. fn is invoked as noexcept, so an exception escaping it
+        // calls std::terminate, catch it inside fn to report it elsewhere
+        template<typename Fn>
+            requires requires(task t) {
+                requires std::invocable<std::decay_t<Fn>&>;
+                t.emplace(std::declval<Fn>());
+            }
+        void post(Fn&& fn)
+        {
+            auto* const t = acquire_task();
+
+            try
+            {
+                t->emplace(cpp_forward(fn));
+            }
+            catch(...)
+            {
+                delete t; // NOLINT(*-owning-memory)
+                throw;
+            }
+
+            pending_.fetch_add(1, std::memory_order_relaxed);
+
+            if(auto* const w = local_worker(); w != nullptr) w->deque.push(t);
+            else inject(t);
+
+            notify();
+        }
+
+        template<typename Fn>
+            requires requires(basic_thread_pool pool) { pool.post(std::declval<Fn>()); }
+        void operator()(Fn&& fn)
+        {
+            post(cpp_forward(fn));
+        }
+
+        // block until every posted task has finished. must not be called from a worker thread.
+        void wait() const noexcept
+        {
+            for(auto pending = pending_.load(std::memory_order_acquire); pending != 0;
+                pending = pending_.load(std::memory_order_acquire))
+                pending_.wait(pending, std::memory_order_acquire);
+        }
+    };
+
+    using thread_pool = basic_thread_pool<>;
+}
@@ -0,0 +1,906 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../coroutine/task.h"
+#include "../cstdint/cstdint.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <coroutine>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+#endif
+
+namespace stdsharp
+{
+    // file opened for positional reads, which neither use nor move a file position and may run
+    // concurrently. where pread is unavailable reads are serialized on a std::ifstream
+    class async_file
+    {
+#if __has_include(<unistd.h>)
+        int fd_;
+#else
+        mutable std::mutex mutex_;
+        mutable std::ifstream fs_;
+#endif
+
+    public:
+        // throws std::filesystem::filesystem_error if the file cannot be opened
+        explicit async_file(const std::filesystem::path& path)
+        {
+#if __has_include(<unistd.h>)
+            fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if(fd_ < 0)
+                throw std::filesystem::filesystem_error{
+                    "cannot open file",
+                    path,
+                    std::error_code{errno, std::generic_category()}
+                };
+#else
+            fs_.open(path, std::ios::binary);
+
+            if(!fs_)
+                throw std::filesystem::filesystem_error{
+                    "cannot open file",
+                    path,
+                    std::make_error_code(std::errc::io_error)
+                };
+#endif
+        }
+
+        async_file(const async_file&) = delete;
+        async_file(async_file&&) = delete;
+        async_file& operator=(const async_file&) = delete;
+        async_file& operator=(async_file&&) = delete;
+
+        ~async_file()
+        {
+#if __has_include(<unistd.h>)
+            ::close(fd_);
+#endif
+        }
+
+#if __has_include(<unistd.h>)
+        [[nodiscard]] int native_handle() const noexcept { return fd_; }
+#endif
+
+        // reads into buffer from offset, returns the number of bytes read which is less than the
+        // buffer size only at the end of file. sets error and returns 0 on failure
+        std::size_t read_at(
+            const std::span<std::byte> buffer,
+            const u64 offset,
+            std::error_code& error
+        ) const noexcept
+        {
+            error.clear();
+
+#if __has_include(<unistd.h>)
+            std::size_t size = 0;
+
+            while(size < buffer.size())
+            {
+                const auto count = ::pread(
+                    fd_,
+                    buffer.data() + size,
+                    buffer.size() - size,
+                    static_cast<::off_t>(offset + size)
+                );
+
+                if(count == 0) break;
+
+                if(count < 0)
+                {
+                    if(errno == EINTR) continue;
+                    error = {errno, std::generic_category()};
+                    return 0;
+                }
+
+                size += static_cast<std::size_t>(count);
+            }
+
+            return size;
+#else
+            const std::scoped_lock lock{mutex_};
+
+            fs_.clear();
+            fs_.seekg(static_cast<std::streamoff>(offset));
+            fs_.read(
+                reinterpret_cast<char*>(buffer.data()), // NOLINT(*-reinterpret-cast)
+                static_cast<std::streamsize>(buffer.size())
+            );
+
+            if(fs_.bad())
+            {
+                error = std::make_error_code(std::errc::io_error);
+                return 0;
+            }
+
+            return static_cast<std::size_t>(fs_.gcount());
+#endif
+        }
+
+        // throws std::system_error on failure
+        std::size_t read_at(const std::span<std::byte> buffer, const u64 offset) const
+        {
+            std::error_code error;
+            const auto size = read_at(buffer, offset, error);
+
+            if(error) throw std::system_error{error, "cannot read file"};
+
+            return size;
+        }
+    };
+}
+
+namespace stdsharp::details
+{
+    struct io_operation
+    {
+        using complete_fn = void (*)(io_operation&);
+        using discard_fn = void (*)(io_operation&) noexcept;
+
+        complete_fn complete;
+        discard_fn discard;
+
+        const async_file* file = nullptr;
+        std::span<std::byte> buffer{};
+        u64 offset = 0;
+        bool fixed = false;
+        u16 buffer_index = 0;
+
+        std::size_t size = 0;
+        int error = 0;
+        bool resubmit = false;
+        io_operation* next = nullptr;
+
+        io_operation(const complete_fn on_complete, const discard_fn on_discard) noexcept:
+            complete(on_complete), discard(on_discard)
+        {
+        }
+
+        [[nodiscard]] std::error_code error_code() const noexcept
+        {
+            return {error, std::generic_category()};
+        }
+    };
+
+    template<typename Fn>
+    struct io_callback_operation : io_operation
+    {
+        Fn fn;
+
+        template<typename... Args>
+        explicit io_callback_operation(Args&&... args):
+            io_operation(
+                [](io_operation& op)
+                {
+                    const std::unique_ptr<io_callback_operation> self{
+                        static_cast<io_callback_operation*>(&op)
+                    };
+                    invoke(self->fn, self->error_code(), self->size);
+                },
+                [](io_operation& op) noexcept
+                {
+                    delete static_cast<io_callback_operation*>(&op); // NOLINT(*-owning-memory)
+                }
+            ),
+            fn(cpp_forward(args)...)
+        {
+        }
+    };
+
+#if __has_include(<linux/io_uring.h>)
+    // submission and completion rings shared with the kernel. the submission array maps every
+    // slot to the entry of the same index once, so pushing only writes the entry and the tail
+    class io_uring_queue
+    {
+        int fd_ = -1;
+        void* sq_ring_ = MAP_FAILED;
+        std::size_t sq_ring_size_ = 0;
+        void* cq_ring_ = MAP_FAILED;
+        std::size_t cq_ring_size_ = 0;
+        ::io_uring_sqe* sqes_ = nullptr;
+        std::size_t sqes_size_ = 0;
+
+        unsigned* sq_head_ = nullptr;
+        unsigned* sq_tail_ = nullptr;
+        unsigned sq_mask_ = 0;
+        unsigned sq_entries_ = 0;
+        unsigned* cq_head_ = nullptr;
+        unsigned* cq_tail_ = nullptr;
+        unsigned cq_mask_ = 0;
+        unsigned cq_entries_ = 0;
+        ::io_uring_cqe* cqes_ = nullptr;
+
+        template<typename T>
+        [[nodiscard]] static T* at(void* const ring, const u32 offset) noexcept
+        {
+            return reinterpret_cast<T*>( // NOLINT(*-reinterpret-cast)
+                static_cast<std::byte*>(ring) + offset
+            );
+        }
+
+        [[nodiscard]] void* map(const std::size_t size, const ::off_t offset) const noexcept
+        {
+            return ::mmap(
+                nullptr,
+                size,
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE,
+                fd_,
+                offset
+            );
+        }
+
+        // kernels before 5.6 lack both IORING_OP_READ and the probe
+        [[nodiscard]] bool supports(const u8 opcode) const noexcept
+        {
+            constexpr auto size =
+                sizeof(::io_uring_probe) + IORING_OP_LAST * sizeof(::io_uring_probe_op);
+
+            alignas(::io_uring_probe) std::array<std::byte, size> storage{};
+            auto* const probe = reinterpret_cast<::io_uring_probe*>( // NOLINT(*-reinterpret-cast)
+                storage.data()
+            );
+
+            if(::syscall(
+                   __NR_io_uring_register,
+                   fd_,
+                   IORING_REGISTER_PROBE,
+                   probe,
+                   IORING_OP_LAST
+               ) < 0)
+                return false;
+
+            return opcode < probe->ops_len &&
+                (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0; // NOLINT
+        }
+
+        void close() noexcept
+        {
+            if(sqes_ != nullptr) ::munmap(sqes_, sqes_size_);
+            if(cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+            if(sq_ring_ != MAP_FAILED) ::munmap(sq_ring_, sq_ring_size_);
+            if(fd_ >= 0) ::close(fd_);
+
+            fd_ = -1;
+            sq_ring_ = cq_ring_ = MAP_FAILED;
+            sqes_ = nullptr;
+        }
+
+    public:
+        io_uring_queue() = default;
+        io_uring_queue(const io_uring_queue&) = delete;
+        io_uring_queue(io_uring_queue&&) = delete;
+        io_uring_queue& operator=(const io_uring_queue&) = delete;
+        io_uring_queue& operator=(io_uring_queue&&) = delete;
+
+        ~io_uring_queue() { close(); }
+
+        // returns false if the kernel does not provide io_uring, refuses to set it up or cannot
+        // read into unregistered buffers
+        bool open(const unsigned entries) noexcept
+        {
+            ::io_uring_params params{};
+
+            fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+
+            if(fd_ < 0) return false;
+
+            if(!supports(IORING_OP_READ))
+            {
+                close();
+                return false;
+            }
+
+            sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+
+            if((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+                sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+            sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+            cq_ring_ = (params.features & IORING_FEAT_SINGLE_MMAP) != 0 ?
+                sq_ring_ :
+                map(cq_ring_size_, IORING_OFF_CQ_RING);
+            sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+
+            if(void* const sqes = map(sqes_size_, IORING_OFF_SQES); sqes != MAP_FAILED)
+                sqes_ = static_cast<::io_uring_sqe*>(sqes);
+
+            if(sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes_ == nullptr)
+            {
+                close();
+                return false;
+            }
+
+            sq_head_ = at<unsigned>(sq_ring_, params.sq_off.head);
+            sq_tail_ = at<unsigned>(sq_ring_, params.sq_off.tail);
+            sq_mask_ = *at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+            sq_entries_ = params.sq_entries;
+            cq_head_ = at<unsigned>(cq_ring_, params.cq_off.head);
+            cq_tail_ = at<unsigned>(cq_ring_, params.cq_off.tail);
+            cq_mask_ = *at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+            cq_entries_ = params.cq_entries;
+            cqes_ = at<::io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+            auto* const array = at<unsigned>(sq_ring_, params.sq_off.array);
+            for(unsigned i = 0; i < sq_entries_; ++i) array[i] = i; // NOLINT(*-pointer-arithmetic)
+
+            return true;
+        }
+
+        [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+
+        [[nodiscard]] unsigned completion_entries() const noexcept { return cq_entries_; }
+
+        // pushes a read of the part of the buffer not filled yet, returns false if the submission
+        // ring is full
+        bool push(const io_operation& op, const bool fixed) noexcept
+        {
+            const auto tail = std::atomic_ref{*sq_tail_}.load(std::memory_order_relaxed);
+
+            if(tail - std::atomic_ref{*sq_head_}.load(std::memory_order_acquire) == sq_entries_)
+                return false;
+
+            auto& sqe = sqes_[tail & sq_mask_]; // NOLINT(*-pointer-arithmetic)
+
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            sqe.fd = op.file->native_handle();
+            sqe.off = op.offset + op.size;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(op.buffer.data() + op.size); // NOLINT
+            sqe.len = static_cast<u32>(op.buffer.size() - op.size);
+            sqe.user_data = reinterpret_cast<std::uintptr_t>(&op); // NOLINT(*-cast)
+            if(fixed) sqe.buf_index = op.buffer_index;
+
+            std::atomic_ref{*sq_tail_}.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // submits every pushed entry and waits for min_complete completions, throws
+        // std::system_error on failure
+        void enter(const unsigned min_complete)
+        {
+            const auto submit = std::atomic_ref{*sq_tail_}.load(std::memory_order_relaxed) -
+                std::atomic_ref{*sq_head_}.load(std::memory_order_acquire);
+
+            if(submit == 0 && min_complete == 0) return;
+
+            while(::syscall(
+                      __NR_io_uring_enter,
+                      fd_,
+                      submit,
+                      min_complete,
+                      min_complete > 0 ? IORING_ENTER_GETEVENTS : 0U,
+                      nullptr,
+                      0
+                  ) < 0)
+                if(errno != EINTR)
+                    throw std::system_error{errno, std::generic_category(), "io_uring_enter"};
+        }
+
+        [[nodiscard]] bool ready() const noexcept
+        {
+            return std::atomic_ref{*cq_head_}.load(std::memory_order_relaxed) !=
+                std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire);
+        }
+
+        // pops a completion and adds its result to the operation, nullptr if there is none. a read
+        // returning less than requested before the end of file marks the operation for resubmit,
+        // a failed one drops the bytes of earlier attempts like async_file::read_at
+        io_operation* pop() noexcept
+        {
+            const auto head = std::atomic_ref{*cq_head_}.load(std::memory_order_relaxed);
+
+            if(head == std::atomic_ref{*cq_tail_}.load(std::memory_order_acquire)) return nullptr;
+
+            const auto& cqe = cqes_[head & cq_mask_]; // NOLINT(*-pointer-arithmetic)
+            auto* const op = reinterpret_cast<io_operation*>(cqe.user_data); // NOLINT(*-cast)
+
+            if(cqe.res < 0)
+            {
+                op->error = -cqe.res;
+                op->size = 0;
+            }
+            else
+            {
+                op->size += static_cast<std::size_t>(cqe.res);
+                op->resubmit = cqe.res > 0 && op->size < op->buffer.size();
+            }
+
+            std::atomic_ref{*cq_head_}.store(head + 1, std::memory_order_release);
+
+            return op;
+        }
+
+        bool register_buffers(const std::span<const std::span<std::byte>> buffers)
+        {
+            std::vector<::iovec> vectors;
+
+            vectors.reserve(buffers.size());
+            for(const auto buffer : buffers) vectors.push_back({buffer.data(), buffer.size()});
+
+            return ::syscall(
+                       __NR_io_uring_register,
+                       fd_,
+                       IORING_REGISTER_BUFFERS,
+                       vectors.data(),
+                       static_cast<unsigned>(vectors.size())
+                   ) == 0;
+        }
+
+        void unregister_buffers() noexcept
+        {
+            ::syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        }
+    };
+#endif
+}
+
+namespace stdsharp
+{
+    inline constexpr unsigned default_io_ring_entries = 256;
+
+    // asynchronous positional reads of async_file. on linux the reads are submitted to an io_uring
+    // of entries slots, elsewhere or if the kernel refuses one they run as blocking reads on the
+    // executor, any invocable accepting a nullary invocable like thread_pool.
+    // reads are queued and submitted together by submit(), poll(), wait() or run(), and their
+    // completions are delivered on the thread calling poll(), wait() or run(). a ring is not thread
+    // safe, the destructor waits for reads in flight and drops completions not delivered yet.
+    template<typename Executor>
+    class io_ring
+    {
+        using operation = details::io_operation;
+
+        Executor* executor_;
+#if __has_include(<linux/io_uring.h>)
+        details::io_uring_queue queue_;
+#endif
+        std::vector<std::span<std::byte>> buffers_;
+        bool registered_ = false;
+
+        operation* pending_first_ = nullptr;
+        operation* pending_last_ = nullptr;
+        std::size_t pending_ = 0;
+        std::size_t in_flight_ = 0;
+
+        std::mutex mutex_;
+        std::condition_variable completion_;
+        operation* completed_ = nullptr;
+
+        void enqueue(operation& op) noexcept
+        {
+            if(pending_last_ == nullptr) pending_first_ = &op;
+            else pending_last_->next = &op;
+
+            pending_last_ = &op;
+            ++pending_;
+        }
+
+        // queues op ahead of the others
+        void requeue(operation& op) noexcept
+        {
+            op.next = pending_first_;
+            pending_first_ = &op;
+            if(pending_last_ == nullptr) pending_last_ = &op;
+            ++pending_;
+        }
+
+        operation& dequeue() noexcept
+        {
+            auto& op = *std::exchange(pending_first_, pending_first_->next);
+
+            if(pending_first_ == nullptr) pending_last_ = nullptr;
+
+            op.next = nullptr;
+            --pending_;
+            return op;
+        }
+
+        static void fill(
+            operation& op,
+            const async_file& file,
+            const std::span<std::byte> buffer,
+            const u64 offset
+        ) noexcept
+        {
+            Expects(buffer.size() <= std::numeric_limits<u32>::max());
+
+            op.file = &file;
+            op.buffer = buffer;
+            op.offset = offset;
+        }
+
+        void fill_fixed(
+            operation& op,
+            const async_file& file,
+            const std::size_t index,
+            const u64 offset,
+            const std::size_t size
+        ) const noexcept
+        {
+            Expects(index < buffers_.size());
+            Expects(size <= buffers_[index].size());
+
+            fill(op, file, buffers_[index].first(size), offset);
+            op.fixed = true;
+            op.buffer_index = static_cast<u16>(index);
+        }
+
+#if __has_include(<linux/io_uring.h>)
+        bool push(const operation& op)
+        {
+            if(in_flight_ >= queue_.completion_entries()) return false;
+
+            const auto fixed = registered_ && op.fixed;
+
+            if(queue_.push(op, fixed)) return true;
+
+            queue_.enter(0);
+            return queue_.push(op, fixed);
+        }
+#endif
+
+        // op must be dequeued, the executor may complete it before this returns
+        void post(operation& op)
+        {
+            try
+            {
+                invoke(
+                    *executor_,
+                    [this, &op]
+                    {
+                        std::error_code error;
+
+                        op.size = op.file->read_at(op.buffer, op.offset, error);
+                        op.error = error.value();
+
+                        // notify while holding the lock, the ring may be destroyed right after
+                        const std::scoped_lock lock{mutex_};
+                        op.next = completed_;
+                        completed_ = &op;
+                        completion_.notify_one();
+                    }
+                );
+            }
+            catch(...)
+            {
+                requeue(op);
+                throw;
+            }
+        }
+
+        operation* next_completion(const bool block)
+        {
+#if __has_include(<linux/io_uring.h>)
+            if(uses_io_uring())
+            {
+                if(block && !queue_.ready()) queue_.enter(1);
+                return queue_.pop();
+            }
+#endif
+
+            std::unique_lock lock{mutex_};
+
+            if(block) completion_.wait(lock, [this] { return completed_ != nullptr; });
+
+            auto* const op = completed_;
+            if(op != nullptr) completed_ = op->next;
+            return op;
+        }
+
+        std::size_t complete(const bool block)
+        {
+            std::size_t count = 0;
+
+            for(auto* op = next_completion(block && in_flight_ > 0); op != nullptr;
+                op = next_completion(false))
+            {
+                --in_flight_;
+
+                if(op->resubmit)
+                {
+                    op->resubmit = false;
+                    requeue(*op);
+                    continue;
+                }
+
+                ++count;
+                op->complete(*op);
+            }
+
+            return count;
+        }
+
+        class read_awaiter : operation
+        {
+            friend class io_ring;
+
+            io_ring& ring_;
+            std::coroutine_handle<> handle_;
+
+            explicit read_awaiter(io_ring& ring) noexcept:
+                operation(
+                    [](operation& op) { static_cast<read_awaiter&>(op).handle_.resume(); },
+                    [](operation& /*unused*/) noexcept {}
+                ),
+                ring_(ring)
+            {
+            }
+
+        public:
+            [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+            void await_suspend(const std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                ring_.enqueue(*this);
+            }
+
+            // throws std::system_error if the read failed
+            std::size_t await_resume() const
+            {
+                if(this->error != 0)
+                    throw std::system_error{this->error_code(), "cannot read file"};
+                return this->size;
+            }
+        };
+
+    public:
+        // falls back to the executor if prefer_io_uring is false or the io_uring cannot be set up,
+        // see uses_io_uring()
+        explicit io_ring(
+            Executor& executor,
+            const unsigned entries = default_io_ring_entries,
+            [[maybe_unused]] const bool prefer_io_uring = true
+        ) noexcept:
+            executor_(&executor)
+        {
+            Expects(entries > 0);
+
+#if __has_include(<linux/io_uring.h>)
+            if(prefer_io_uring) queue_.open(entries);
+#endif
+        }
+
+        io_ring(const io_ring&) = delete;
+        io_ring(io_ring&&) = delete;
+        io_ring& operator=(const io_ring&) = delete;
+        io_ring& operator=(io_ring&&) = delete;
+
+        ~io_ring()
+        {
+            while(pending_first_ != nullptr)
+            {
+                auto& op = dequeue();
+                op.discard(op);
+            }
+
+            try
+            {
+                for(; in_flight_ > 0; --in_flight_)
+                    if(auto* const op = next_completion(true); op != nullptr) op->discard(*op);
+            }
+            catch(...) // NOLINT(*-empty-catch)
+            {
+            }
+
+#if __has_include(<linux/io_uring.h>)
+            if(registered_) queue_.unregister_buffers();
+#endif
+        }
+
+        // true if reads are submitted to the kernel rather than run on the executor
+        [[nodiscard]] bool uses_io_uring() const noexcept
+        {
+#if __has_include(<linux/io_uring.h>)
+            return queue_.is_open();
+#else
+            return false;
+#endif
+        }
+
+        // reads queued or in flight
+        [[nodiscard]] std::size_t outstanding() const noexcept { return pending_ + in_flight_; }
+
+        // buffers for read_fixed, replacing previous ones. with io_uring they are registered with
+        // the kernel, which pins them and saves mapping them on every read. returns false if they
+        // are not registered, read_fixed then reads into them like read does.
+        // must not be called while reads are outstanding
+        bool register_buffers(const std::span<const std::span<std::byte>> buffers)
+        {
+            Expects(outstanding() == 0);
+            Expects(buffers.size() <= std::numeric_limits<u16>::max() + std::size_t{1});
+
+            unregister_buffers();
+            buffers_.assign(buffers.begin(), buffers.end());
+
+#if __has_include(<linux/io_uring.h>)
+            registered_ = uses_io_uring() && queue_.register_buffers(buffers_);
+#endif
+
+            return registered_;
+        }
+
+        void unregister_buffers() noexcept
+        {
+            Expects(outstanding() == 0);
+
+#if __has_include(<linux/io_uring.h>)
+            if(registered_) queue_.unregister_buffers();
+#endif
+
+            registered_ = false;
+            buffers_.clear();
+        }
+
+        [[nodiscard]] std::span<std::byte> buffer(const std::size_t index) const noexcept
+        {
+            Expects(index < buffers_.size());
+            return buffers_[index];
+        }
+
+        // queues a read into buffer from offset of file, fn(std::error_code, std::size_t) receives
+        // the error and the number of bytes read, which is less than requested only at the end of
+        // file and 0 on error. buffer holds at most 2^32 - 1 bytes, file and buffer must stay valid
+        // until fn is invoked
+        template<typename Fn>
+            requires std::invocable<std::decay_t<Fn>&, std::error_code, std::size_t>
+        void read(
+            const async_file& file,
+            const std::span<std::byte> buffer,
+            const u64 offset,
+            Fn&& fn
+        )
+        {
+            auto op = std::make_unique<details::io_callback_operation<std::decay_t<Fn>>>( //
+                cpp_forward(fn)
+            );
+
+            fill(*op, file, buffer, offset);
+            enqueue(*op.release());
+        }
+
+        // like read, into the first size bytes of the registered buffer at index
+        template<typename Fn>
+            requires std::invocable<std::decay_t<Fn>&, std::error_code, std::size_t>
+        void read_fixed(
+            const async_file& file,
+            const std::size_t index,
+            const u64 offset,
+            const std::size_t size,
+            Fn&& fn
+        )
+        {
+            auto op = std::make_unique<details::io_callback_operation<std::decay_t<Fn>>>( //
+                cpp_forward(fn)
+            );
+
+            fill_fixed(*op, file, index, offset, size);
+            enqueue(*op.release());
+        }
+
+        // awaitable read resuming the coroutine with the number of bytes read from poll(), wait()
+        // or run(). the read is queued when the coroutine suspends
+        [[nodiscard]] read_awaiter
+            async_read(const async_file& file, const std::span<std::byte> buffer, const u64 offset)
+        {
+            read_awaiter awaiter{*this};
+            fill(awaiter, file, buffer, offset);
+            return awaiter;
+        }
+
+        [[nodiscard]] read_awaiter async_read_fixed(
+            const async_file& file,
+            const std::size_t index,
+            const u64 offset,
+            const std::size_t size
+        )
+        {
+            read_awaiter awaiter{*this};
+            fill_fixed(awaiter, file, index, offset, size);
+            return awaiter;
+        }
+
+        // submits queued reads as one batch, returns how many were submitted. with io_uring at
+        // most as many reads as the completion ring holds are in flight, the rest stay queued
+        std::size_t submit()
+        {
+            std::size_t count = 0;
+
+            for(; pending_first_ != nullptr; ++count)
+            {
+#if __has_include(<linux/io_uring.h>)
+                if(uses_io_uring())
+                {
+                    if(!push(*pending_first_)) break;
+                    dequeue();
+                }
+                else post(dequeue());
+#else
+                post(dequeue());
+#endif
+
+                ++in_flight_;
+            }
+
+#if __has_include(<linux/io_uring.h>)
+            if(uses_io_uring()) queue_.enter(0);
+#endif
+
+            return count;
+        }
+
+        // submits queued reads and delivers the completed ones without blocking, returns how many
+        // were delivered
+        std::size_t poll()
+        {
+            submit();
+            return complete(false);
+        }
+
+        // like poll, but blocks until at least one read completes if any is outstanding
+        std::size_t wait()
+        {
+            std::size_t count = 0;
+
+            // a short read is resubmitted rather than delivered
+            do
+            {
+                submit();
+                count = complete(true);
+            } while(count == 0 && outstanding() > 0);
+
+            return count;
+        }
+
+        // delivers completions until no read is outstanding, including those queued by handlers
+        std::size_t run()
+        {
+            std::size_t count = 0;
+            while(outstanding() > 0) count += wait();
+            return count;
+        }
+
+        // runs the task on the calling thread, driving the ring until it completes. the task must
+        // only wait for reads of this ring
+        template<typename T>
+        T sync_wait(task<T> t)
+        {
+            if(auto ready = t.when_ready(); !ready.await_ready())
+                ready.await_suspend(std::noop_coroutine()).resume();
+
+            while(!t.done())
+            {
+                Expects(outstanding() > 0);
+                wait();
+            }
+
+            return cpp_move(t).operator co_await().await_resume();
+        }
+    };
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "mapped_file.h"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace stdsharp
+{
+    // views a file of packed T, written by record_writer or any raw array dump, as
+    // std::span<const T> directly over its memory map. the view is valid while this is alive.
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class mapped_records
+    {
+        mapped_file file_;
+        std::span<const T> records_;
+
+        [[noreturn]] static void throw_error(const char* what, const std::filesystem::path& path)
+        {
+            throw std::filesystem::filesystem_error{
+                what,
+                path,
+                std::make_error_code(std::errc::invalid_argument)
+            };
+        }
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using const_iterator = std::span<const T>::iterator;
+
+        mapped_records() = default;
+
+        // records start offset bytes into the file, e.g. past a header. throws
+        // std::filesystem::filesystem_error if the file cannot be read, if the remaining size is
+        // not a multiple of sizeof(T) or if the records are not aligned to alignof(T)
+        explicit mapped_records(const std::filesystem::path& path, const size_type offset = 0):
+            file_(path)
+        {
+            if(offset > file_.size()) throw_error("record offset exceeds file size", path);
+
+            const auto size = file_.size() - offset;
+
+            if(size % sizeof(T) != 0)
+                throw_error("file size is not a multiple of record size", path);
+
+            if(size == 0) return;
+
+            const auto* const first = file_.data() + offset;
+
+            if(std::bit_cast<std::uintptr_t>(first) % alignof(T) != 0)
+                throw_error("records are misaligned", path);
+
+            records_ = {
+                reinterpret_cast<const T*>(first), // NOLINT(*-reinterpret-cast)
+                size / sizeof(T)
+            };
+        }
+
+        mapped_records(const mapped_records&) = delete;
+        mapped_records& operator=(const mapped_records&) = delete;
+
+        mapped_records(mapped_records&& other) noexcept:
+            file_(cpp_move(other.file_)), records_(std::exchange(other.records_, {}))
+        {
+        }
+
+        mapped_records& operator=(mapped_records&& other) noexcept
+        {
+            if(this == &other) return *this;
+
+            file_ = cpp_move(other.file_);
+            records_ = std::exchange(other.records_, {});
+            return *this;
+        }
+
+        ~mapped_records() = default;
+
+        [[nodiscard]] std::span<const T> records() const noexcept { return records_; }
+
+        [[nodiscard]] const T* data() const noexcept { return records_.data(); }
+
+        [[nodiscard]] size_type size() const noexcept { return records_.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return records_.empty(); }
+
+        [[nodiscard]] const T& operator[](const size_type index) const noexcept
+        {
+            Expects(index < size());
+            return records_[index];
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return records_.begin(); }
+
+        [[nodiscard]] const_iterator end() const noexcept { return records_.end(); }
+
+        [[nodiscard]] const mapped_file& file() const noexcept { return file_; }
+
+        bool advise(const access_advice advice) const noexcept { return file_.advise(advice); }
+    };
+
+    // appends packed T to a file through one buffer of buffer_size bytes, spans at least as large
+    // as the buffer are written directly. the stream itself is unbuffered so bytes are copied once.
+    // the destructor writes what remains but cannot report errors, call flush() to observe them.
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class record_writer
+    {
+        std::filesystem::path path_;
+        std::ofstream fs_;
+        std::vector<std::byte> buffer_;
+        std::size_t size_ = 0;
+
+        void write_bytes(const std::byte* const bytes, const std::size_t count)
+        {
+            fs_.write(
+                reinterpret_cast<const char*>(bytes), // NOLINT(*-reinterpret-cast)
+                static_cast<std::streamsize>(count)
+            );
+        }
+
+        void write_buffer()
+        {
+            write_bytes(buffer_.data(), size_);
+            size_ = 0;
+        }
+
+        void check() const
+        {
+            if(!fs_)
+                throw std::filesystem::filesystem_error{
+                    "cannot write file",
+                    path_,
+                    std::make_error_code(std::errc::io_error)
+                };
+        }
+
+    public:
+        using value_type = T;
+
+        static constexpr std::size_t default_buffer_size = std::size_t{1} << 20;
+
+        // mode is combined with std::ios::out | std::ios::binary, pass std::ios::app to append.
+        // throws std::filesystem::filesystem_error if the file cannot be opened
+        explicit record_writer(
+            std::filesystem::path path,
+            const std::ios::openmode mode = std::ios::trunc,
+            const std::size_t buffer_size = default_buffer_size
+        ):
+            path_(cpp_move(path)), buffer_(std::max(buffer_size, sizeof(T)))
+        {
+            fs_.rdbuf()->pubsetbuf(nullptr, 0);
+            fs_.open(path_, mode | std::ios::out | std::ios::binary);
+
+            if(!fs_)
+                throw std::filesystem::filesystem_error{
+                    "cannot open file",
+                    path_,
+                    std::make_error_code(std::errc::io_error)
+                };
+        }
+
+        record_writer(const record_writer&) = delete;
+        record_writer(record_writer&&) = delete;
+        record_writer& operator=(const record_writer&) = delete;
+        record_writer& operator=(record_writer&&) = delete;
+
+        ~record_writer()
+        {
+            if(size_ > 0 && fs_) write_buffer();
+        }
+
+        void write(const T& record)
+        {
+            if(buffer_.size() - size_ < sizeof(T))
+            {
+                write_buffer();
+                check();
+            }
+
+            std::memcpy(buffer_.data() + size_, &record, sizeof(T));
+            size_ += sizeof(T);
+        }
+
+        void write(const std::span<const T> records)
+        {
+            const auto bytes = std::as_bytes(records);
+
+            if(buffer_.size() - size_ < bytes.size())
+            {
+                write_buffer();
+
+                if(bytes.size() >= buffer_.size())
+                {
+                    write_bytes(bytes.data(), bytes.size());
+                    check();
+                    return;
+                }
+
+                check();
+            }
+
+            std::ranges::copy(bytes, buffer_.begin() + static_cast<std::ptrdiff_t>(size_));
+            size_ += bytes.size();
+        }
+
+        // writes buffered records to the file, throws std::filesystem::filesystem_error on failure
+        void flush()
+        {
+            write_buffer();
+            fs_.flush();
+            check();
+        }
+    };
+}
+
+namespace stdsharp::details
+{
+    template<typename T>
+    struct map_records_fn
+    {
+        [[nodiscard]] mapped_records<T>
+            operator()(const std::filesystem::path& path, const std::size_t offset = 0) const
+        {
+            return mapped_records<T>{path, offset};
+        }
+    };
+}
+
+namespace stdsharp
+{
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    inline constexpr details::map_records_fn<T> map_records{};
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "../cassert/cassert.h"
+#include "../coroutine/generator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace stdsharp::details
+{
+    // forward only reader filling whole buffers, uses a file descriptor with kernel read ahead
+    // hints where available and std::ifstream otherwise
+    class sequential_file
+    {
+#if __has_include(<unistd.h>)
+        int fd_;
+        std::size_t offset_ = 0;
+#else
+        std::ifstream fs_;
+#endif
+
+    public:
+        explicit sequential_file(const std::filesystem::path& path)
+        {
+#if __has_include(<unistd.h>)
+            fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if(fd_ < 0)
+                throw std::filesystem::filesystem_error{
+                    "cannot open file",
+                    path,
+                    std::error_code{errno, std::generic_category()}
+                };
+
+    #ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    #endif
+#else
+            fs_.open(path, std::ios::binary);
+
+            if(!fs_)
+                throw std::filesystem::filesystem_error{
+                    "cannot open file",
+                    path,
+                    std::make_error_code(std::errc::io_error)
+                };
+#endif
+        }
+
+        sequential_file(const sequential_file&) = delete;
+        sequential_file(sequential_file&&) = delete;
+        sequential_file& operator=(const sequential_file&) = delete;
+        sequential_file& operator=(sequential_file&&) = delete;
+
+        ~sequential_file()
+        {
+#if __has_include(<unistd.h>)
+            ::close(fd_);
+#endif
+        }
+
+        // fills buffer unless the end of file is reached first, returns the number of bytes read.
+        // the kernel is asked to start reading the following read_ahead bytes in the background
+        std::size_t
+            read(const std::span<std::byte> buffer, [[maybe_unused]] const std::size_t read_ahead)
+        {
+#if __has_include(<unistd.h>)
+            std::size_t size = 0;
+
+            while(size < buffer.size())
+            {
+                const auto count = ::read(fd_, buffer.data() + size, buffer.size() - size);
+
+                if(count == 0) break;
+
+                if(count < 0)
+                {
+                    if(errno == EINTR) continue;
+                    throw std::system_error{errno, std::generic_category(), "cannot read file"};
+                }
+
+                size += static_cast<std::size_t>(count);
+            }
+
+            offset_ += size;
+
+    #ifdef POSIX_FADV_WILLNEED
+            if(size == buffer.size())
+                ::posix_fadvise(
+                    fd_,
+                    static_cast<::off_t>(offset_),
+                    static_cast<::off_t>(read_ahead),
+                    POSIX_FADV_WILLNEED
+                );
+    #endif
+
+            return size;
+#else
+            fs_.read(
+                reinterpret_cast<char*>(buffer.data()), // NOLINT(*-reinterpret-cast)
+                static_cast<std::streamsize>(buffer.size())
+            );
+
+            if(fs_.bad()) throw std::system_error{std::make_error_code(std::errc::io_error)};
+
+            return static_cast<std::size_t>(fs_.gcount());
+#endif
+        }
+    };
+}
+
+namespace stdsharp
+{
+    inline constexpr std::size_t default_read_chunk_size = std::size_t{1} << 20;
+
+    // lazily reads a file in chunks of chunk_size bytes, the last one may be shorter. every chunk
+    // views the same buffer and is valid until the next increment, so memory stays constant.
+    // the file is opened on the first begin(), which throws std::filesystem::filesystem_error if
+    // it fails
+    inline constexpr struct read_chunks_fn
+    {
+        [[nodiscard]] generator<std::span<const std::byte>> operator()(
+            const std::filesystem::path path, // NOLINT(*-unnecessary-value-param)
+            const std::size_t chunk_size = default_read_chunk_size
+        ) const
+        {
+            Expects(chunk_size > 0);
+
+            details::sequential_file file{path};
+            std::vector<std::byte> buffer(chunk_size);
+
+            while(true)
+            {
+                const auto size = file.read(buffer, chunk_size);
+
+                if(size == 0) co_return;
+
+                co_yield std::span<const std::byte>{buffer.data(), size};
+
+                if(size < chunk_size) co_return;
+            }
+        }
+    } read_chunks{};
+
+    // lazily reads a file as records separated by delimiter, not including it. a final record
+    // without a trailing delimiter is yielded too. records view an internal buffer of chunk_size
+    // bytes, which only grows to fit a record longer than it, and are valid until the next
+    // increment. the file is opened on the first begin() like read_chunks
+    inline constexpr struct read_records_fn
+    {
+        [[nodiscard]] generator<std::string_view> operator()(
+            const std::filesystem::path path, // NOLINT(*-unnecessary-value-param)
+            const char delimiter = '\n',
+            const std::size_t chunk_size = default_read_chunk_size
+        ) const
+        {
+            Expects(chunk_size > 0);
+
+            details::sequential_file file{path};
+            std::vector<char> buffer(chunk_size);
+            std::size_t first = 0;
+            std::size_t last = 0;
+
+            while(true)
+            {
+                // make room by moving the incomplete record to the front, or grow if it fills all
+                if(last == buffer.size())
+                {
+                    if(first == 0) buffer.resize(buffer.size() * 2);
+                    else
+                    {
+                        std::ranges::copy(
+                            buffer.begin() + static_cast<std::ptrdiff_t>(first),
+                            buffer.begin() + static_cast<std::ptrdiff_t>(last),
+                            buffer.begin()
+                        );
+                        last -= first;
+                        first = 0;
+                    }
+                }
+
+                const auto size =
+                    file.read(std::as_writable_bytes(std::span{buffer}.subspan(last)), chunk_size);
+
+                if(size == 0)
+                {
+                    if(first != last)
+                        co_yield std::string_view{buffer.data() + first, last - first};
+                    co_return;
+                }
+
+                const std::string_view view{buffer.data(), last + size};
+
+                for(auto pos = view.find(delimiter, last); pos != std::string_view::npos;
+                    pos = view.find(delimiter, first))
+                {
+                    co_yield view.substr(first, pos - first);
+                    first = pos + 1;
+                }
+
+                last += size;
+            }
+        }
+    } read_records{};
+}
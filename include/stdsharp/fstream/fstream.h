@@ -2,8 +2,11 @@
 
 #include "../containers/actions.h"
 
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
 #include <fstream>
+#include <vector>
 
 namespace stdsharp
 {
@@ -28,26 +31,165 @@ namespace stdsharp
 
     namespace details
     {
+        // types whose operator>> reads a number, char types read a single character instead
         template<typename T>
-            requires std::invocable<get_from_stream_fn<T>, std::ifstream>
+        concept from_chars_parsable = std::is_arithmetic_v<T> && !std::same_as<T, bool> &&
+            !std::same_as<T, char> && !std::same_as<T, signed char> &&
+            !std::same_as<T, unsigned char> && !std::same_as<T, wchar_t> &&
+            !std::same_as<T, char8_t> && !std::same_as<T, char16_t> && !std::same_as<T, char32_t>;
+
+        [[nodiscard]] constexpr bool is_stream_space(const char c) noexcept
+        {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        // parses whitespace separated values in [first, last) until the end or the first token
+        // that is not a T, returns where parsing stopped
+        template<typename T, typename Container>
+        constexpr const char*
+            parse_all_chars(Container& container, const char* first, const char* const last)
+        {
+            while(true)
+            {
+                first = std::ranges::find_if_not(first, last, is_stream_space);
+
+                if(first == last) return first;
+
+                // operator>> accepts an explicit plus sign, from_chars does not
+                const auto* const number =
+                    *first == '+' && last - first > 1 && first[1] != '-' ? first + 1 : first;
+
+                T value{};
+                const auto [ptr, ec] = std::from_chars(number, last, value);
+
+                if(ec != std::errc{}) return first;
+
+                actions::emplace_back(container, value);
+                first = ptr;
+            }
+        }
+
+        template<typename T>
+            requires std::invocable<get_from_stream_fn<T>, std::istream&>
         struct read_all_to_container_fn
         {
+        private:
+            static constexpr std::size_t chunk_size = std::size_t{1} << 20;
+
+            // reads the file in chunks and parses each with from_chars. a token crossing the end of
+            // a chunk is moved to the front of the buffer and completed by the next read.
+            template<typename Container>
+            static void
+                read_chars(Container& container, std::istream& is, const std::size_t file_size)
+            {
+                std::vector<char> buffer(chunk_size);
+                std::size_t carry = 0;
+                auto reserved = false;
+
+                while(true)
+                {
+                    is.read(
+                        buffer.data() + carry,
+                        static_cast<std::streamsize>(buffer.size() - carry)
+                    );
+
+                    const auto end = carry + static_cast<std::size_t>(is.gcount());
+                    const auto eof = !is;
+                    const auto* const first = buffer.data();
+                    const auto* complete = first + end;
+
+                    if(!eof)
+                    {
+                        complete = std::ranges::find_if(
+                                       std::reverse_iterator{complete},
+                                       std::reverse_iterator{first},
+                                       is_stream_space
+                        ).base();
+
+                        // a single token fills the buffer
+                        if(complete == first)
+                        {
+                            carry = end;
+                            buffer.resize(buffer.size() * 2);
+                            continue;
+                        }
+                    }
+
+                    const auto size_before = std::ranges::size(container);
+                    const auto* const stopped = parse_all_chars<T>(container, first, complete);
+
+                    if(stopped != complete) return;
+
+                    // estimate the element count from the density of the first chunk
+                    if constexpr(requires { container.reserve(std::size_t{}); })
+                        if(!reserved)
+                        {
+                            reserved = true;
+
+                            const auto parsed = std::ranges::size(container) - size_before;
+                            const auto consumed = static_cast<std::size_t>(complete - first);
+
+                            if(parsed > 0 && file_size > consumed)
+                                container.reserve(
+                                    std::ranges::size(container) +
+                                    (file_size - consumed) / (consumed / parsed)
+                                );
+                        }
+
+                    if(eof) return;
+
+                    carry = static_cast<std::size_t>(first + end - complete);
+                    std::ranges::copy(complete, first + end, buffer.data());
+                }
+            }
+
+            template<typename Container>
+            static constexpr bool parse_chars =
+                from_chars_parsable<T> && std::ranges::sized_range<Container>;
+
+        public:
+            // same as the std::istream overload, the file is read in binary mode and its size is
+            // used to reserve the container
             template<typename Container = std::vector<T>>
-                requires std::invocable<read_all_to_container_fn, Container&>
+                requires std::invocable<actions::emplace_back_fn, Container&, T>
             [[nodiscard]] auto& operator()(
                 Container& container,
                 const std::filesystem::path& path //
             ) const
             {
-                std::ifstream fs{path};
-                return (*this)(container, fs);
+                if constexpr(parse_chars<Container>)
+                {
+                    std::ifstream fs{path, std::ios::binary};
+                    std::error_code ec;
+                    const auto file_size = std::filesystem::file_size(path, ec);
+
+                    read_chars(container, fs, ec ? 0 : static_cast<std::size_t>(file_size));
+                    return container;
+                }
+                else
+                {
+                    std::ifstream fs{path};
+                    return (*this)(container, fs);
+                }
             }
 
+            // arithmetic values are parsed with std::from_chars until the end of the stream or the
+            // first token that is not a T, e.g. a negative value of an unsigned type or a value out
+            // of range. "inf" and "nan" are read as floating point values. the stream is read in
+            // chunks, so it may be consumed past that token.
+            // other types are read with operator>> until the stream fails. the value of the
+            // failed read is still appended, e.g. a value initialized T when the input ends with
+            // whitespace
             template<typename Container = std::vector<T>>
                 requires std::invocable<actions::emplace_back_fn, Container&, T>
             [[nodiscard]] constexpr auto& operator()(Container& container, std::istream& is) const
             {
-                while(is) actions::emplace_back(container, get_from_stream<T>(is));
+                if constexpr(parse_chars<Container>) read_chars(container, is, 0);
+                else
+                {
+                    while(is) actions::emplace_back(container, get_from_stream<T>(is));
+                }
+
                 return container;
             }
         };
@@ -65,13 +207,13 @@ namespace stdsharp
             [[nodiscard]] constexpr auto operator()(std::istream& is) const
             {
                 Container container{};
-                return read_all_to_container<T>(container, is);
+                return cpp_move(read_all_to_container<T>(container, is));
             }
 
             [[nodiscard]] auto operator()(const std::filesystem::path& path) const
             {
-                std::ifstream fs{path};
-                return (*this)(fs);
+                Container container{};
+                return cpp_move(read_all_to_container<T>(container, path));
             }
         };
 
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "../scope.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace stdsharp
+{
+    enum class access_advice : std::uint8_t
+    {
+        normal,
+        sequential,
+        random,
+        will_need,
+        dont_need
+    };
+
+    // read only view of a whole file. regular files are memory mapped and unmapped on destruction,
+    // anything that cannot be mapped, like pipes, character devices or files reporting size 0,
+    // is read into an owned buffer instead. where mmap is unavailable the file is always read.
+    class mapped_file
+    {
+        std::byte* map_ = nullptr;
+        std::size_t size_ = 0;
+        std::vector<std::byte> buffer_;
+
+        [[noreturn]] static void throw_error(
+            const char* what,
+            const std::filesystem::path& path,
+            const std::error_code error = {errno, std::generic_category()}
+        )
+        {
+            throw std::filesystem::filesystem_error{what, path, error};
+        }
+
+        void unmap() noexcept
+        {
+#if __has_include(<sys/mman.h>)
+            if(map_ != nullptr) ::munmap(map_, size_);
+#endif
+            map_ = nullptr;
+        }
+
+#if __has_include(<sys/mman.h>)
+        void read_fd(const int fd, const std::filesystem::path& path, const std::size_t size_hint)
+        {
+            constexpr std::size_t min_read = 64 * 1024;
+
+            buffer_.resize(std::max(size_hint, min_read));
+
+            for(std::size_t size = 0;;)
+            {
+                if(size == buffer_.size()) buffer_.resize(size * 2);
+
+                const auto count = ::read(fd, buffer_.data() + size, buffer_.size() - size);
+
+                if(count < 0)
+                {
+                    if(errno == EINTR) continue;
+                    throw_error("cannot read file", path);
+                }
+
+                if(count == 0)
+                {
+                    buffer_.resize(size);
+                    break;
+                }
+
+                size += static_cast<std::size_t>(count);
+            }
+
+            size_ = buffer_.size();
+        }
+#endif
+
+    public:
+        mapped_file() = default;
+
+        // throws std::filesystem::filesystem_error if the file cannot be opened or read
+        explicit mapped_file(const std::filesystem::path& path)
+        {
+#if __has_include(<sys/mman.h>)
+            const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if(fd < 0) throw_error("cannot open file", path);
+
+            const auto closer = scope::make_scoped<scope::exit_fn_policy::on_exit>( //
+                [fd]() noexcept { ::close(fd); }
+            );
+
+            struct ::stat status{};
+
+            if(::fstat(fd, &status) != 0) throw_error("cannot stat file", path);
+
+            const auto size = static_cast<std::size_t>(status.st_size);
+
+            if(S_ISREG(status.st_mode) && size > 0)
+                if(auto* const map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                   map != MAP_FAILED)
+                {
+                    map_ = static_cast<std::byte*>(map);
+                    size_ = size;
+                    return;
+                }
+
+            read_fd(fd, path, S_ISREG(status.st_mode) ? size : 0);
+#else
+            constexpr std::size_t chunk_size = 64 * 1024;
+
+            const auto error = std::make_error_code(std::errc::io_error);
+            std::ifstream fs{path, std::ios::binary};
+
+            if(!fs) throw_error("cannot open file", path, error);
+
+            while(fs)
+            {
+                buffer_.resize(size_ + chunk_size);
+                fs.read(
+                    reinterpret_cast<char*>(buffer_.data() + size_), // NOLINT(*-reinterpret-cast)
+                    chunk_size
+                );
+                size_ += static_cast<std::size_t>(fs.gcount());
+            }
+
+            if(fs.bad()) throw_error("cannot read file", path, error);
+
+            buffer_.resize(size_);
+#endif
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept:
+            map_(std::exchange(other.map_, nullptr)),
+            size_(std::exchange(other.size_, 0)),
+            buffer_(std::exchange(other.buffer_, {}))
+        {
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            if(this == &other) return *this;
+
+            unmap();
+            map_ = std::exchange(other.map_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            buffer_ = std::exchange(other.buffer_, {});
+            return *this;
+        }
+
+        ~mapped_file() { unmap(); }
+
+        [[nodiscard]] const std::byte* data() const noexcept
+        {
+            return map_ == nullptr ? buffer_.data() : map_;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        // true if contents are memory mapped rather than read into a buffer
+        [[nodiscard]] bool is_mapped() const noexcept { return map_ != nullptr; }
+
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {data(), size_}; }
+
+        [[nodiscard]] std::string_view text() const noexcept
+        {
+            return {reinterpret_cast<const char*>(data()), size_}; // NOLINT(*-reinterpret-cast)
+        }
+
+        // hints the expected access pattern of a mapping, returns false if the hint is not applied
+        bool advise([[maybe_unused]] const access_advice advice) const noexcept
+        {
+#if __has_include(<sys/mman.h>)
+            if(map_ == nullptr) return false;
+
+            const auto native = [advice]
+            {
+                switch(advice)
+                {
+                case access_advice::sequential: return POSIX_MADV_SEQUENTIAL;
+                case access_advice::random: return POSIX_MADV_RANDOM;
+                case access_advice::will_need: return POSIX_MADV_WILLNEED;
+                case access_advice::dont_need: return POSIX_MADV_DONTNEED;
+                default: return POSIX_MADV_NORMAL;
+                }
+            }();
+
+            return ::posix_madvise(map_, size_, native) == 0;
+#else
+            return false;
+#endif
+        }
+
+        void swap(mapped_file& other) noexcept
+        {
+            std::swap(map_, other.map_);
+            std::swap(size_, other.size_);
+            buffer_.swap(other.buffer_);
+        }
+
+        friend void swap(mapped_file& left, mapped_file& right) noexcept { left.swap(right); }
+    };
+}
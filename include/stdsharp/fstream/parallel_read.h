@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../execution/parallel_policy.h"
+#include "fstream.h"
+#include "mapped_file.h"
+
+#include <numeric>
+
+namespace stdsharp::details
+{
+    template<from_chars_parsable T, std::default_initializable Container>
+        requires std::invocable<actions::emplace_back_fn, Container&, T>
+    struct parallel_read_all_fn
+    {
+        // maps the file, splits it into the chunks of policy and moves every split point past the
+        // token it falls into. chunks are parsed concurrently into their own vectors, which are
+        // appended to the result in file order. like read_all, parsing stops at the first token
+        // that is not a T. throws std::filesystem::filesystem_error if the file cannot be read
+        template<typename Executor>
+        [[nodiscard]] Container
+            operator()(const parallel_policy<Executor>& policy, const std::filesystem::path& path)
+                const
+        {
+            const mapped_file file{path};
+
+            file.advise(access_advice::sequential);
+
+            const auto text = file.text();
+            const auto count = policy.chunk_count(text.size());
+            std::vector<std::vector<T>> parts(count);
+            std::vector<char> stopped(count);
+
+            const auto split_point = [text](std::size_t index)
+            {
+                while(index > 0 && index < text.size() && !is_stream_space(text[index - 1]))
+                    ++index;
+                return index;
+            };
+
+            policy.for_each_chunk(
+                text.size(),
+                [&](const std::size_t first, const std::size_t last, const std::size_t index)
+                {
+                    const auto* const begin = text.data() + split_point(first);
+                    const auto* const end = text.data() + split_point(last);
+
+                    stopped[index] = parse_all_chars<T>(parts[index], begin, end) != end ? 1 : 0;
+                }
+            );
+
+            Container container{};
+
+            if constexpr(requires { container.reserve(std::size_t{}); })
+                container.reserve(std::transform_reduce(
+                    parts.cbegin(),
+                    parts.cend(),
+                    std::size_t{0},
+                    std::plus{},
+                    [](const auto& part) { return part.size(); }
+                ));
+
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const auto& part = parts[i];
+
+                if constexpr(requires {
+                                 container.insert(container.end(), part.begin(), part.end());
+                             })
+                    container.insert(container.end(), part.begin(), part.end());
+                else
+                    for(const auto value : part) actions::emplace_back(container, value);
+
+                if(stopped[i] != 0) break;
+            }
+
+            return container;
+        }
+    };
+}
+
+namespace stdsharp
+{
+    template<typename T, typename Container = std::vector<T>>
+    inline constexpr details::parallel_read_all_fn<T, Container> parallel_read_all{};
+}
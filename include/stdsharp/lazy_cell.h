@@ -0,0 +1,275 @@
+#pragma once
+
+#include "concepts/object.h"
+#include "functional/invoke.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace stdsharp
+{
+    class cell_graph;
+}
+
+namespace stdsharp::details
+{
+    class cell_node
+    {
+        friend class stdsharp::cell_graph;
+
+    protected:
+        cell_graph* graph_;
+        std::vector<cell_node*> dependencies_;
+        std::vector<cell_node*> dependents_;
+        std::size_t height_ = 0;
+        bool dirty_ = false;
+        // whether the graph lists this for recompute(); get() clears dirty_ but not this
+        bool queued_ = false;
+        void (*recompute_)(cell_node&) = nullptr;
+
+        inline cell_node(cell_graph& graph, void (*recompute)(cell_node&));
+
+        constexpr void unlink_dependencies() noexcept
+        {
+            for(auto* const dependency : dependencies_) std::erase(dependency->dependents_, this);
+            dependencies_.clear();
+        }
+
+        inline void track() noexcept;
+
+        inline void invalidate_dependents();
+
+    public:
+        cell_node(const cell_node&) = delete;
+        cell_node(cell_node&&) = delete;
+        cell_node& operator=(const cell_node&) = delete;
+        cell_node& operator=(cell_node&&) = delete;
+
+        inline ~cell_node();
+
+        [[nodiscard]] constexpr bool dirty() const noexcept { return dirty_; }
+
+        [[nodiscard]] constexpr std::size_t height() const noexcept { return height_; }
+
+        [[nodiscard]] constexpr const auto& dependencies() const noexcept { return dependencies_; }
+
+        [[nodiscard]] constexpr const auto& dependents() const noexcept { return dependents_; }
+    };
+}
+
+namespace stdsharp
+{
+    template<std::invocable Fn>
+    class derived_cell;
+
+    class cell_graph
+    {
+        friend class details::cell_node;
+
+        template<std::invocable Fn>
+        friend class derived_cell;
+
+        details::cell_node* tracking_ = nullptr;
+        std::vector<details::cell_node*> dirty_;
+
+        void track(details::cell_node& node) noexcept
+        {
+            if(tracking_ == nullptr) return;
+
+            auto& dependencies = tracking_->dependencies_;
+
+            if(std::ranges::find(dependencies, &node) != dependencies.cend()) return;
+
+            dependencies.push_back(&node);
+            node.dependents_.push_back(tracking_);
+        }
+
+        void invalidate(details::cell_node& node)
+        {
+            auto pending = node.dependents_;
+
+            while(!pending.empty())
+            {
+                auto& current = *pending.back();
+                pending.pop_back();
+
+                if(current.dirty_) continue;
+
+                mark_dirty(current);
+                pending.insert(
+                    pending.cend(),
+                    current.dependents_.cbegin(),
+                    current.dependents_.cend()
+                );
+            }
+        }
+
+        void mark_dirty(details::cell_node& node)
+        {
+            node.dirty_ = true;
+
+            if(node.queued_) return;
+
+            dirty_.push_back(&node);
+            node.queued_ = true;
+        }
+
+        void erase(const details::cell_node& node) noexcept { std::erase(dirty_, &node); }
+
+        template<std::invocable Fn>
+        decltype(auto) track_with(details::cell_node& node, Fn&& fn)
+        {
+            struct restore // NOLINT(*-special-member-functions)
+            {
+                cell_graph& graph;
+                details::cell_node* previous;
+
+                ~restore() { graph.tracking_ = previous; }
+            } guard{*this, std::exchange(tracking_, &node)};
+
+            return invoke(cpp_forward(fn));
+        }
+
+    public:
+        cell_graph() = default;
+        cell_graph(const cell_graph&) = delete;
+        cell_graph(cell_graph&&) = delete;
+        cell_graph& operator=(const cell_graph&) = delete;
+        cell_graph& operator=(cell_graph&&) = delete;
+        ~cell_graph() = default;
+
+        // cells queued for recompute(), including ones get() has already brought up to date
+        [[nodiscard]] std::size_t dirty_count() const noexcept { return dirty_.size(); }
+
+        // recompute every invalidated cell in topological order, so that each cell is evaluated
+        // at most once and after all of its dependencies
+        void recompute()
+        {
+            auto pending = std::exchange(dirty_, {});
+
+            std::ranges::sort(pending, {}, &details::cell_node::height_);
+
+            for(auto* const node : pending) node->queued_ = false;
+
+            for(auto* const node : pending)
+                if(node->dirty_) node->recompute_(*node);
+        }
+    };
+}
+
+namespace stdsharp::details
+{
+    cell_node::cell_node(cell_graph& graph, void (*recompute)(cell_node&)):
+        graph_(&graph), recompute_(recompute)
+    {
+        if(recompute_ != nullptr) graph_->mark_dirty(*this);
+    }
+
+    void cell_node::track() noexcept { graph_->track(*this); }
+
+    void cell_node::invalidate_dependents() { graph_->invalidate(*this); }
+
+    cell_node::~cell_node()
+    {
+        unlink_dependencies();
+
+        for(auto* const dependent : dependents_)
+        {
+            std::erase(dependent->dependencies_, this);
+
+            graph_->mark_dirty(*dependent);
+        }
+
+        graph_->erase(*this);
+    }
+}
+
+namespace stdsharp
+{
+    template<typename T>
+    class input_cell : public details::cell_node
+    {
+        T value_;
+
+    public:
+        using value_type = T;
+
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        explicit input_cell(cell_graph& graph, Args&&... args)
+            noexcept(nothrow_constructible_from<T, Args...>):
+            cell_node(graph, nullptr), value_(cpp_forward(args)...)
+        {
+        }
+
+        [[nodiscard]] const T& get() noexcept
+        {
+            track();
+            return value_;
+        }
+
+        [[nodiscard]] const T& cget() const noexcept { return value_; }
+
+        template<typename U = T>
+            requires std::assignable_from<T&, U>
+        void set(U&& value)
+        {
+            if constexpr(std::equality_comparable_with<T, U>)
+                if(value_ == value) return;
+
+            value_ = cpp_forward(value);
+            invalidate_dependents();
+        }
+    };
+
+    template<std::invocable Fn>
+    class derived_cell : public details::cell_node
+    {
+    public:
+        using value_type = std::invoke_result_t<Fn&>;
+
+    private:
+        Fn fn_;
+        std::optional<value_type> value_;
+
+        static void recompute(cell_node& node)
+        {
+            auto& self = static_cast<derived_cell&>(node);
+
+            self.unlink_dependencies();
+            self.value_.reset();
+            self.graph_->track_with(self, [&self] { self.value_.emplace(invoke(self.fn_)); });
+            self.dirty_ = false;
+
+            std::size_t height = 0;
+            for(const auto* const dependency : self.dependencies_)
+                height = std::max(height, dependency->height() + 1);
+            self.height_ = height;
+        }
+
+    public:
+        template<typename... Args>
+            requires std::constructible_from<Fn, Args...>
+        explicit derived_cell(cell_graph& graph, Args&&... args)
+            noexcept(nothrow_constructible_from<Fn, Args...>):
+            cell_node(graph, recompute), fn_(cpp_forward(args)...)
+        {
+        }
+
+        [[nodiscard]] const value_type& get()
+        {
+            track();
+            if(dirty_) recompute(*this);
+            return *value_;
+        }
+
+        [[nodiscard]] const value_type& cget() const noexcept { return *value_; }
+
+        [[nodiscard]] bool has_value() const noexcept { return value_.has_value(); }
+    };
+
+    template<typename Fn>
+    derived_cell(cell_graph&, Fn&&) -> derived_cell<std::decay_t<Fn>>;
+}
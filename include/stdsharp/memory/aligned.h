@@ -7,6 +7,10 @@
 
 namespace stdsharp
 {
+    // std::hardware_destructive_interference_size is allowed to vary between compiler flags,
+    // which makes it unsuitable for layouts shared across translation units
+    inline constexpr std::size_t cache_line_size = 64;
+
     inline constexpr struct align_fn
     {
         template<non_const T, std::size_t Size>
@@ -83,6 +83,21 @@ namespace stdsharp
         {
         }
 
+        template<typename OtherFirst, typename OtherSecond>
+            requires(!std::same_as<composed_allocator<OtherFirst, OtherSecond>,
+                                   composed_allocator>) &&
+            std::constructible_from<FirstAlloc, const OtherFirst&> &&
+            std::constructible_from<SecondAlloc, const OtherSecond&>
+        constexpr composed_allocator( //
+            const composed_allocator<OtherFirst, OtherSecond>& other
+        ) noexcept:
+            composed_allocator(
+                FirstAlloc(other.get_first_allocator()),
+                SecondAlloc(other.get_second_allocator())
+            )
+        {
+        }
+
         [[nodiscard]] constexpr auto allocate(const std::size_t n, const void* const hint = nullptr)
         {
             const auto ptr = first_traits::
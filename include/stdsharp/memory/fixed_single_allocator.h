@@ -81,7 +81,8 @@ namespace stdsharp
         };
 
         template<typename U>
-        constexpr fixed_single_allocator(const typename rebind<U>::other other) noexcept:
+        constexpr fixed_single_allocator(const fixed_single_allocator<U, Size> other
+        ) noexcept:
             fixed_single_allocator(other.resource())
         {
         }
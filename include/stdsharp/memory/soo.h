@@ -1,3 +1,5 @@
+#pragma once
+
 #include "box.h"
 #include "composed_allocator.h"
 #include "fixed_single_allocator.h"
@@ -3,7 +3,13 @@
 #include "mutex/mutex.h"
 #include "utility/forward_cast.h"
 
+#include <array>
+#include <chrono>
+#include <optional>
 #include <shared_mutex>
+#include <span>
+#include <thread>
+#include <tuple>
 
 namespace stdsharp
 {
@@ -100,4 +106,157 @@ namespace stdsharp
 
     template<typename T>
     synchronizer(T&&) -> synchronizer<std::decay_t<T>>;
+}
+
+namespace stdsharp::details
+{
+    template<typename T>
+    concept synchronized_value = requires(T& t) {
+        t.value;
+        requires lockable<decltype(t.lock)>;
+    };
+
+    template<typename>
+    inline constexpr bool is_timed_lock = false;
+
+    template<timed_lockable Lockable>
+    inline constexpr bool is_timed_lock<std::unique_lock<Lockable>> = true;
+
+    template<shared_timed_lockable Lockable>
+    inline constexpr bool is_timed_lock<std::shared_lock<Lockable>> = true;
+
+    template<typename T>
+    concept timed_synchronized_value = synchronized_value<T> &&
+        is_timed_lock<std::remove_cvref_t<decltype(std::declval<T&>().lock)>>;
+
+    template<typename TimePoint>
+    struct timed_lock_ref
+    {
+        void* lock;
+        bool (*try_lock_until)(void*, const TimePoint&);
+        bool (*try_lock)(void*);
+        void (*unlock)(void*);
+
+        template<typename Lock>
+        constexpr timed_lock_ref(Lock& l) noexcept:
+            lock(&l),
+            try_lock_until(
+                [](void* const ptr, const TimePoint& deadline)
+                {
+                    return static_cast<Lock*>(ptr)->try_lock_until(deadline); //
+                }
+            ),
+            try_lock([](void* const ptr) { return static_cast<Lock*>(ptr)->try_lock(); }),
+            unlock([](void* const ptr) { static_cast<Lock*>(ptr)->unlock(); })
+        {
+        }
+    };
+
+    // same back-off strategy as std::lock, but the blocking acquisition is bounded by deadline
+    template<typename TimePoint>
+    bool try_lock_until(
+        const std::span<const timed_lock_ref<TimePoint>> locks,
+        const TimePoint& deadline
+    )
+    {
+        const auto size = locks.size();
+
+        for(std::size_t first = 0;;)
+        {
+            if(!locks[first].try_lock_until(locks[first].lock, deadline)) return false;
+
+            std::size_t i = 1;
+
+            for(; i < size; ++i)
+            {
+                const auto& current = locks[(first + i) % size];
+                if(!current.try_lock(current.lock)) break;
+            }
+
+            if(i == size) return true;
+
+            for(auto j = i; j-- > 0;)
+            {
+                const auto& acquired = locks[(first + j) % size];
+                acquired.unlock(acquired.lock);
+            }
+
+            if(TimePoint::clock::now() >= deadline) return false;
+
+            first = (first + i) % size;
+            std::this_thread::yield();
+        }
+    }
+}
+
+namespace stdsharp
+{
+    inline constexpr struct synchronize_fn
+    {
+        template<details::synchronized_value... T>
+            requires(sizeof...(T) > 0)
+        [[nodiscard]] auto operator()(T&&... values) const
+        {
+            std::tuple<std::decay_t<T>...> res{cpp_forward(values)...};
+
+            std::apply(
+                [](auto&... v)
+                {
+                    if constexpr(sizeof...(v) == 1) (v.lock.lock(), ...);
+                    else std::lock(v.lock...);
+                },
+                res
+            );
+
+            return res;
+        }
+    } synchronize{};
+
+    inline constexpr struct try_synchronize_until_fn
+    {
+        template<typename Clock, typename Duration, details::timed_synchronized_value... T>
+            requires(sizeof...(T) > 0)
+        [[nodiscard]] auto operator()(
+            const std::chrono::time_point<Clock, Duration>& deadline,
+            T&&... values
+        ) const
+        {
+            using tuple_t = std::tuple<std::decay_t<T>...>;
+            using time_point = std::chrono::time_point<Clock, Duration>;
+            using lock_ref = details::timed_lock_ref<time_point>;
+
+            std::optional<tuple_t> res{std::in_place, cpp_forward(values)...};
+
+            const auto locked = std::apply(
+                [&deadline](auto&... v)
+                {
+                    const std::array<lock_ref, sizeof...(v)> locks{lock_ref{v.lock}...};
+                    return details::try_lock_until<time_point>(locks, deadline);
+                },
+                *res
+            );
+
+            if(!locked) res.reset();
+
+            return res;
+        }
+    } try_synchronize_until{};
+
+    inline constexpr struct try_synchronize_for_fn
+    {
+        template<typename Rep, typename Period, typename... T>
+            requires std::invocable<
+                try_synchronize_until_fn,
+                std::chrono::steady_clock::time_point,
+                T...>
+        [[nodiscard]] auto
+            operator()(const std::chrono::duration<Rep, Period>& duration, T&&... values) const
+        {
+            return try_synchronize_until(
+                std::chrono::steady_clock::now() +
+                    std::chrono::ceil<std::chrono::steady_clock::duration>(duration),
+                cpp_forward(values)...
+            );
+        }
+    } try_synchronize_for{};
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include "stdsharp/algorithm/algorithm.h"
+#include "stdsharp/execution/thread_pool.h"
 #include "stdsharp/type_traits/object.h"
 #include "test.h"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <numeric>
+#include <thread>
+
 STDSHARP_TEST_NAMESPACES;
 
 TEMPLATE_TEST_CASE_SIG(
@@ -31,6 +36,61 @@ TEMPLATE_TEST_CASE_SIG(
     }
 }
 
+SCENARIO("atomic set if", "[algorithm]")
+{
+    GIVEN("an atomic value")
+    {
+        atomic<int> value{5};
+
+        THEN("only greater value is stored")
+        {
+            REQUIRE(set_if_greater(value, 3) == 5);
+            REQUIRE(set_if_greater(value, 7) == 7);
+            REQUIRE(value == 7);
+        }
+
+        THEN("only less value is stored by atomic ref")
+        {
+            int raw = 5;
+
+            REQUIRE(set_if_less(atomic_ref{raw}, 7) == 5);
+            REQUIRE(set_if_less(atomic_ref{raw}, 3) == 3);
+            REQUIRE(raw == 3);
+        }
+    }
+
+    GIVEN("multiple threads updating running max and min")
+    {
+        constexpr auto thread_count = 4;
+        constexpr auto count = 10'000;
+
+        atomic<int> max{0};
+        atomic<int> min{count * thread_count};
+
+        {
+            vector<jthread> threads;
+
+            for(auto i = 0; i < thread_count; ++i)
+                threads.emplace_back(
+                    [&, i]
+                    {
+                        for(auto j = 0; j < count; ++j)
+                        {
+                            set_if_greater(max, j * thread_count + i);
+                            set_if_less(min, j * thread_count + i);
+                        }
+                    }
+                );
+        }
+
+        THEN("extremes are recorded")
+        {
+            REQUIRE(max == count * thread_count - 1);
+            REQUIRE(min == 0);
+        }
+    }
+}
+
 TEMPLATE_TEST_CASE_SIG(
     "Scenario: is between",
     "[algorithm]",
@@ -90,4 +150,98 @@ SCENARIO("move n", "[algorithm]")
     array<unique_object, 3> v0{};
     array<unique_object, 3> v1{};
     move_n(v0.begin(), v0.size(), v1.begin());
+}
+
+SCENARIO("parallel algorithms", "[algorithm]")
+{
+    thread_pool pool{4};
+    const parallel_policy policy{pool, 4, 16};
+
+    vector<int> left(1000);
+    iota(left.begin(), left.end(), 0);
+
+    GIVEN("two ranges")
+    {
+        auto right = left;
+
+        THEN("equal ranges are equivalent")
+        {
+            REQUIRE(strict_compare(policy, left, right) == partial_ordering::equivalent);
+        }
+
+        WHEN("last element of right is smaller")
+        {
+            right.back() = 0;
+
+            THEN("left is greater")
+            {
+                REQUIRE(strict_compare(policy, left, right) == partial_ordering::greater);
+            }
+
+            AND_WHEN("first element of right is greater")
+            {
+                right.front() = 1;
+
+                THEN("ranges are unordered")
+                {
+                    REQUIRE(strict_compare(policy, left, right) == partial_ordering::unordered);
+                }
+            }
+        }
+
+        WHEN("right is shorter")
+        {
+            right.pop_back();
+
+            THEN("ranges are unordered")
+            {
+                REQUIRE(strict_compare(policy, left, right) == partial_ordering::unordered);
+            }
+        }
+    }
+
+    GIVEN("a range of unique objects")
+    {
+        vector<unique_ptr<int>> src(1000);
+        vector<unique_ptr<int>> dst(src.size());
+
+        for(auto i = 0; auto& ptr : src) ptr = make_unique<int>(i++);
+
+        WHEN("move n elements")
+        {
+            const auto [in, out] = move_n(policy, src.begin(), ssize(src), dst.begin());
+
+            THEN("all elements are moved")
+            {
+                REQUIRE(in == src.end());
+                REQUIRE(out == dst.end());
+                REQUIRE(std::ranges::all_of(src, [](const auto& ptr) { return ptr == nullptr; }));
+                for(auto i = 0; const auto& ptr : dst) REQUIRE(*ptr == i++);
+            }
+        }
+    }
+
+    GIVEN("min and max values")
+    {
+        auto max = 5;
+        auto min = 5;
+
+        THEN("set if greater or less to the range extremes")
+        {
+            REQUIRE(set_if_greater(policy, max, left) == 999);
+            REQUIRE(set_if_less(policy, min, left) == 0);
+        }
+    }
+}
+
+TEST_CASE("parallel strict compare benchmark", "[.][benchmark][algorithm]")
+{
+    thread_pool pool;
+    const parallel_policy policy{pool};
+    const vector<int> left(1 << 24, 1);
+    const auto right = left;
+
+    BENCHMARK("sequential") { return strict_compare(left, right); };
+
+    BENCHMARK("parallel") { return strict_compare(policy, left, right); };
 }
\ No newline at end of file
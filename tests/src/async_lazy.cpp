@@ -0,0 +1,51 @@
+#include "stdsharp/async_lazy.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("async lazy", "[async_lazy]")
+{
+    GIVEN("an async lazy value")
+    {
+        atomic_size_t invoked{};
+        async_lazy lazy{[&invoked]
+                        {
+                            ++invoked;
+                            return string{"foo"};
+                        }};
+
+        WHEN("start on the default worker and get value")
+        {
+            REQUIRE(lazy.start());
+            REQUIRE(!lazy.start());
+
+            THEN("value is computed once")
+            {
+                REQUIRE(lazy.get() == "foo");
+                REQUIRE(invoked == 1);
+            }
+        }
+
+        WHEN("start on an executor that has not run the task yet")
+        {
+            vector<decltype(lazy)::task> queue;
+
+            REQUIRE(lazy.start([&queue](auto task) { queue.push_back(cpp_move(task)); }));
+
+            THEN("get computes the value and the queued task becomes a no-op")
+            {
+                REQUIRE(lazy.get() == "foo");
+
+                for(const auto& task : queue) task();
+
+                REQUIRE(invoked == 1);
+                REQUIRE(lazy.cget() == "foo");
+            }
+        }
+
+        WHEN("never started")
+        {
+            THEN("get still computes the value") { REQUIRE(lazy.get() == "foo"); }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include "stdsharp/bitset/atomic_bitset.h"
+#include "test.h"
+
+#include <thread>
+#include <vector>
+
+STDSHARP_TEST_NAMESPACES;
+
+TEMPLATE_TEST_CASE(
+    "atomic bitset",
+    "[bitset][atomic_bitset]",
+    atomic_bitset<100>,
+    (atomic_bitset<100, true>)
+)
+{
+    STATIC_REQUIRE(word_readable_bitset<TestType>);
+
+    GIVEN("an empty atomic bitset")
+    {
+        TestType set;
+
+        THEN("try set returns the previous value")
+        {
+            REQUIRE(!set.try_set(3));
+            REQUIRE(set.try_set(3));
+            REQUIRE(set[3]);
+            REQUIRE(set.try_reset(3));
+            REQUIRE(!set.try_reset(3));
+            REQUIRE(set.none());
+        }
+
+        WHEN("whole words are set")
+        {
+            set.set(99);
+
+            const auto previous = set.fetch_or(1, ~u64{0});
+
+            THEN("bits past size are not set")
+            {
+                REQUIRE(previous == u64{1} << 35);
+                REQUIRE(set.count() == 36);
+                REQUIRE(std::ranges::equal(
+                    bitset_set_bits(set) | views::take(2),
+                    std::array<size_t, 2>{64, 65}
+                ));
+                REQUIRE(std::ranges::count(bitset_crng(set), true) == 36);
+            }
+        }
+
+        THEN("claims take the first unset bit")
+        {
+            REQUIRE(set.claim_first_unset(70) == 70);
+            REQUIRE(set.claim_first_unset(70) == 71);
+            REQUIRE(set.claim_first_unset() == 0);
+
+            set.set_all();
+
+            REQUIRE(set.all());
+            REQUIRE(set.claim_first_unset() == TestType::npos);
+        }
+    }
+}
+
+SCENARIO("atomic bitset concurrent claims", "[bitset][atomic_bitset]")
+{
+    GIVEN("multiple threads claiming bits")
+    {
+        constexpr auto thread_count = 4;
+        constexpr size_t size = 4'000;
+
+        atomic_bitset<size, true> set;
+        vector<vector<size_t>> claimed(thread_count);
+
+        {
+            vector<jthread> threads;
+
+            for(auto i = 0; i < thread_count; ++i)
+                threads.emplace_back(
+                    [&set, &claimed, i]
+                    {
+                        for(auto index = set.claim_first_unset(); index != set.npos;
+                            index = set.claim_first_unset())
+                            claimed[i].push_back(index);
+                    }
+                );
+        }
+
+        THEN("every bit is claimed exactly once")
+        {
+            vector<size_t> all;
+
+            for(const auto& indices : claimed)
+                all.insert(all.end(), indices.begin(), indices.end());
+
+            std::ranges::sort(all);
+
+            REQUIRE(set.all());
+            REQUIRE(std::ranges::equal(all, views::iota(size_t{0}, size)));
+        }
+    }
+}
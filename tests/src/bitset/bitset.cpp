@@ -1,6 +1,8 @@
 #include "stdsharp/bitset/bitset.h"
 #include "test.h"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
+
 STDSHARP_TEST_NAMESPACES;
 
 SCENARIO("bitset iterator", "[bitset]")
@@ -19,4 +21,77 @@ SCENARIO("bitset range", "[bitset]")
     REQUIRE(bitset_rng(set)[0] == true);
     REQUIRE(bitset_crng(set)[1] == false);
     REQUIRE(bitset_rng(as_const(set))[1] == false);
-}
\ No newline at end of file
+}
+
+SCENARIO("bitset set bits", "[bitset]")
+{
+    STATIC_REQUIRE(forward_iterator<bitset_bit_iterator<bitset<4>>>);
+    STATIC_REQUIRE(std::ranges::forward_range<decltype(bitset_set_bits(bitset<4>{}))>);
+
+    GIVEN("a bitset spanning multiple words")
+    {
+        bitset<200> set;
+        set.set(0).set(63).set(64).set(130).set(199);
+
+        THEN("set bits are visited in order")
+        {
+            REQUIRE_THAT(
+                bitset_set_bits(set) | std::ranges::to<vector>(),
+                Catch::Matchers::RangeEquals(vector<size_t>{0, 63, 64, 130, 199})
+            );
+        }
+
+        THEN("set bits after an index are visited")
+        {
+            REQUIRE_THAT(
+                bitset_set_bits(set, 64) | std::ranges::to<vector>(),
+                Catch::Matchers::RangeEquals(vector<size_t>{64, 130, 199})
+            );
+            REQUIRE(std::ranges::empty(bitset_set_bits(set, 200)));
+        }
+
+        THEN("unset bits count matches")
+        {
+            REQUIRE(std::ranges::distance(bitset_unset_bits(set)) == 195);
+            REQUIRE(*bitset_unset_bits(set).begin() == 1);
+        }
+    }
+
+    THEN("constant evaluated bits are correct")
+    {
+        constexpr auto sum = []
+        {
+            constexpr bitset<70> set{0b1001};
+            size_t sum = 0;
+            for(const auto i : bitset_set_bits(set)) sum += i;
+            return sum;
+        }();
+
+        STATIC_REQUIRE(sum == 3);
+    }
+}
+
+TEST_CASE("sparse bitset iteration benchmark", "[.][benchmark][bitset]")
+{
+    static bitset<(1 << 22)> set;
+
+    for(size_t i = 0; i < set.size(); i += 4099) set.set(i);
+
+    BENCHMARK("bitset_crng")
+    {
+        size_t sum = 0;
+        for(size_t i = 0; const auto bit : bitset_crng(set))
+        {
+            if(bit) sum += i;
+            ++i;
+        }
+        return sum;
+    };
+
+    BENCHMARK("bitset_set_bits")
+    {
+        size_t sum = 0;
+        for(const auto i : bitset_set_bits(set)) sum += i;
+        return sum;
+    };
+}
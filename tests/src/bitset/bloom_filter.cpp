@@ -0,0 +1,123 @@
+#include "stdsharp/bitset/bloom_filter.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <vector>
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    void check_filter(auto& filter)
+    {
+        using filter_t = std::remove_cvref_t<decltype(filter)>;
+
+        for(auto i = 0; i < 1'000; ++i) filter.insert(i * 2);
+
+        THEN("inserted keys are found")
+        {
+            for(auto i = 0; i < 1'000; ++i) REQUIRE(filter.contains(i * 2));
+        }
+
+        THEN("false positive rate is low")
+        {
+            auto count = 0;
+            for(auto i = 0; i < 1'000; ++i) count += filter.contains(i * 2 + 1) ? 1 : 0;
+            REQUIRE(count < 50);
+        }
+
+        THEN("batched lookup matches contains")
+        {
+            const auto keys = views::iota(0, 100);
+            vector<bool> found;
+
+            filter.contains_n(keys.begin(), keys.size(), std::back_inserter(found));
+
+            REQUIRE(found.size() == keys.size());
+            for(const auto key : keys) REQUIRE(found[key] == filter.contains(key));
+        }
+
+        THEN("serialization round trips")
+        {
+            const auto bytes = filter.serialize();
+
+            REQUIRE(filter_t::deserialize(bytes).bits() == filter.bits());
+            REQUIRE_THROWS_AS(
+                filter_t::deserialize(std::span{bytes}.first(bytes.size() - 1)),
+                std::invalid_argument
+            );
+        }
+
+        WHEN("filter is cleared")
+        {
+            filter.clear();
+
+            THEN("nothing is found") { REQUIRE(!filter.contains(0)); }
+        }
+    }
+}
+
+SCENARIO("bloom filter", "[bitset][bloom_filter]")
+{
+    GIVEN("a bloom filter with 7 hashes")
+    {
+        bloom_filter<int> filter{16'000, 7};
+
+        check_filter(filter);
+
+        THEN("a bit count whose word count overflows is rejected")
+        {
+            // bit count 2^64 - 2 and hash count 2^64 - 1 without any words
+            vector<std::byte> bytes(16, std::byte{0xff});
+            bytes.front() = std::byte{0xfe};
+
+            REQUIRE_THROWS_AS(bloom_filter<int>::deserialize(bytes), std::invalid_argument);
+        }
+    }
+
+    GIVEN("a blocked bloom filter")
+    {
+        blocked_bloom_filter<int> filter{16'000};
+
+        REQUIRE(filter.bit_count() % decltype(filter)::block_bits == 0);
+
+        check_filter(filter);
+    }
+
+    GIVEN("a bloom filter of strings")
+    {
+        bloom_filter<string> filter{1'000, 3};
+
+        filter.insert("key");
+
+        THEN("the key is found") { REQUIRE(filter.contains("key")); }
+    }
+}
+
+TEST_CASE("bloom filter benchmark", "[.][benchmark][bitset][bloom_filter]")
+{
+    constexpr auto key_count = 1 << 20;
+
+    bloom_filter<int> filter{key_count * 10, 7};
+    blocked_bloom_filter<int> blocked{key_count * 12};
+    vector<char> found(key_count);
+
+    for(auto i = 0; i < key_count; ++i)
+    {
+        filter.insert(i);
+        blocked.insert(i);
+    }
+
+    const auto keys = views::iota(0, key_count);
+
+    BENCHMARK("bloom filter contains_n")
+    {
+        return filter.contains_n(keys.begin(), key_count, found.begin());
+    };
+
+    BENCHMARK("blocked bloom filter contains_n")
+    {
+        return blocked.contains_n(keys.begin(), key_count, found.begin());
+    };
+}
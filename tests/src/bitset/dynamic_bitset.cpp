@@ -0,0 +1,103 @@
+#include "stdsharp/bitset/dynamic_bitset.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("dynamic bitset", "[bitset][dynamic_bitset]")
+{
+    STATIC_REQUIRE(word_bitset<dynamic_bitset<>>);
+
+    GIVEN("a bitset of 130 bits with 3 bits set")
+    {
+        dynamic_bitset<> set{130};
+        set.set(0).set(64).set(129);
+
+        THEN("bits are observable")
+        {
+            REQUIRE(set.size() == 130);
+            REQUIRE(set.word_count() == 3);
+            REQUIRE(set.count() == 3);
+            REQUIRE(set[64]);
+            REQUIRE(!set[65]);
+            REQUIRE(set == dynamic_bitset<>{bitset<130>{}.set(0).set(64).set(129)});
+        }
+
+        THEN("set bits can be found")
+        {
+            REQUIRE(set.find_first() == 0);
+            REQUIRE(set.find_next(0) == 64);
+            REQUIRE(set.find_next(64) == 129);
+            REQUIRE(set.find_next(129) == dynamic_bitset<>::npos);
+        }
+
+        THEN("range adaptors visit the bits")
+        {
+            STATIC_REQUIRE(std::ranges::random_access_range<decltype(bitset_rng(set))>);
+
+            REQUIRE(bitset_crng(set).size() == 130);
+            REQUIRE(bitset_crng(set)[129]);
+            REQUIRE(std::ranges::distance(bitset_set_bits(set)) == 3);
+            REQUIRE(std::ranges::distance(bitset_unset_bits(set)) == 127);
+
+            bitset_rng(set)[1] = true;
+            REQUIRE(set[1]);
+        }
+
+        WHEN("shift left by 65")
+        {
+            set <<= 65;
+
+            THEN("bits past the size are dropped")
+            {
+                REQUIRE(set.count() == 2);
+                REQUIRE(set[65]);
+                REQUIRE(set[129]);
+            }
+        }
+
+        WHEN("shift right by 64")
+        {
+            set >>= 64;
+
+            THEN("bits before 0 are dropped")
+            {
+                REQUIRE(set.count() == 2);
+                REQUIRE(set[0]);
+                REQUIRE(set[65]);
+            }
+        }
+
+        WHEN("combine with another bitset")
+        {
+            dynamic_bitset<> other{130, true};
+
+            THEN("word-wise operations are applied")
+            {
+                REQUIRE((set & other) == set);
+                REQUIRE((set | other).all());
+                REQUIRE((set ^ other).count() == 127);
+                REQUIRE(dynamic_bitset<>{other}.and_not(set) == ~set);
+            }
+        }
+
+        WHEN("resize and push back")
+        {
+            set.resize(200, true);
+            set.push_back(false);
+
+            THEN("new bits are initialized")
+            {
+                REQUIRE(set.size() == 201);
+                REQUIRE(set.count() == 3 + 70);
+                REQUIRE(!set[200]);
+            }
+
+            AND_WHEN("shrink to 64 bits")
+            {
+                set.resize(64);
+
+                THEN("only the first bit is left") { REQUIRE(set.count() == 1); }
+            }
+        }
+    }
+}
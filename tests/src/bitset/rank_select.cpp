@@ -0,0 +1,152 @@
+#include "stdsharp/bitset/dynamic_bitset.h"
+#include "stdsharp/bitset/rank_select.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+STDSHARP_TEST_NAMESPACES;
+
+TEMPLATE_TEST_CASE("rank select", "[bitset][rank_select]", bitset<5000>, dynamic_bitset<>)
+{
+    GIVEN("a bitset with every third bit set")
+    {
+        TestType set = []
+        {
+            if constexpr(same_as<TestType, dynamic_bitset<>>) return TestType{5000};
+            else return TestType{};
+        }();
+
+        for(size_t i = 0; i < set.size(); i += 3) set.set(i);
+
+        const rank_select index{set};
+
+        THEN("rank counts set bits before index")
+        {
+            REQUIRE(index.count() == 1667);
+            REQUIRE(index.rank(0) == 0);
+            REQUIRE(index.rank(1) == 1);
+            REQUIRE(index.rank(3000) == 1000);
+            REQUIRE(index.rank(5000) == 1667);
+            REQUIRE(index.rank0(3000) == 2000);
+        }
+
+        THEN("select finds the k-th set bit")
+        {
+            REQUIRE(index.select(0) == 0);
+            REQUIRE(index.select(1000) == 3000);
+            REQUIRE(index.select(1666) == 4998);
+        }
+
+        THEN("select is the inverse of rank")
+        {
+            for(size_t k = 0; k < index.count(); k += 97) REQUIRE(index.rank(index.select(k)) == k);
+        }
+    }
+}
+
+SCENARIO("rank select over narrow super blocks", "[bitset][rank_select]")
+{
+    // block counts are relative to a count kept for every 2^13 bits
+    constexpr size_t super_block = 1 << 13;
+
+    GIVEN("a bitset set sparsely everywhere and densely around each super block boundary")
+    {
+        dynamic_bitset<> set{3 * super_block + 4096};
+
+        for(size_t i = 0; i < set.size(); i += 37) set.set(i);
+        for(auto boundary = super_block; boundary < set.size(); boundary += super_block)
+            for(auto i = boundary - 3000; i < boundary + 3000; ++i) set.set(i);
+
+        const rank_select<dynamic_bitset<>, 13> index{set};
+
+        THEN("rank and select match a naive count at every bit")
+        {
+            size_t count = 0;
+
+            for(size_t i = 0; i < set.size(); ++i)
+            {
+                REQUIRE(index.rank(i) == count);
+
+                if(set[i]) REQUIRE(index.select(count++) == i);
+            }
+
+            REQUIRE(index.rank(set.size()) == count);
+            REQUIRE(index.count() == count);
+        }
+    }
+}
+
+// the same boundary at the default width, allocates 512 MiB
+SCENARIO("rank select over more than one super block", "[.][bitset][rank_select]")
+{
+    // block counts are relative to a count kept for every 2^32 bits
+    constexpr auto super_block = static_cast<size_t>(u64{1} << 32);
+
+    if constexpr(sizeof(size_t) >= sizeof(u64))
+    {
+        GIVEN("a bitset set sparsely everywhere and densely around 2^32")
+        {
+            const auto size = super_block + 4096;
+            dynamic_bitset<> set{size};
+
+            for(size_t i = 0; i < size; i += 4099) set.set(i);
+            for(auto i = super_block - 3000; i < super_block + 3000; ++i) set.set(i);
+
+            const rank_select index{set};
+
+            // bits before first are counted once, the rest one by one
+            const auto first = super_block - 2048;
+            size_t count_before = 0;
+
+            for(const auto word : set.words().first(first / 64)) count_before += popcount(word);
+
+            const auto naive_rank = [&](const size_t i)
+            {
+                auto count = count_before;
+                for(auto j = first; j < i; ++j) count += set[j] ? 1 : 0;
+                return count;
+            };
+
+            THEN("rank matches a naive count at the boundary")
+            {
+                for(const auto i :
+                    {super_block - 2048,
+                     super_block - 1,
+                     super_block,
+                     super_block + 1,
+                     super_block + 2048,
+                     size})
+                    REQUIRE(index.rank(i) == naive_rank(i));
+            }
+
+            THEN("select finds the bits at the boundary")
+            {
+                const auto k = naive_rank(super_block);
+
+                REQUIRE(index.select(k - 1) == super_block - 1);
+                REQUIRE(index.select(k) == super_block);
+                REQUIRE(index.select(k + 1) == super_block + 1);
+                REQUIRE(index.rank(index.select(index.count() - 1)) == index.count() - 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("rank benchmark", "[.][benchmark][bitset][rank_select]")
+{
+    static bitset<(1 << 20)> set;
+
+    for(size_t i = 0; i < set.size(); i += 7) set.set(i);
+
+    const rank_select index{set};
+    constexpr auto position = set.size() - 1;
+
+    BENCHMARK("popcount loop over bitset_crng")
+    {
+        return std::ranges::count(bitset_crng(set) | views::take(position), true);
+    };
+
+    BENCHMARK("rank") { return index.rank(position); };
+
+    BENCHMARK("select") { return index.select(index.count() - 1); };
+}
@@ -0,0 +1,197 @@
+#include "stdsharp/bitset/roaring_bitmap.h"
+#include "test.h"
+
+#include <numeric>
+#include <set>
+#include <vector>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("roaring bitmap", "[bitset][roaring_bitmap]")
+{
+    GIVEN("values spread over dense, sparse and consecutive chunks")
+    {
+        roaring_bitmap bitmap;
+        std::set<u32> expected;
+
+        for(u32 i = 0; i < 20'000; i += 3) expected.insert(i);
+        for(u32 i = 0; i < 100; ++i) expected.insert((u32{7} << 16) + i * 500);
+        for(u32 i = 0; i < 50'000; ++i) expected.insert((u32{9} << 16) + i);
+
+        for(const auto value : expected) REQUIRE(bitmap.add(value));
+
+        const auto check = [&expected](const roaring_bitmap& b)
+        {
+            REQUIRE(b.size() == expected.size());
+            REQUIRE(std::ranges::equal(roaring_crng(b), expected));
+        };
+
+        THEN("it holds exactly the added values")
+        {
+            check(bitmap);
+            REQUIRE_FALSE(bitmap.add(3));
+            REQUIRE(bitmap.contains((u32{7} << 16) + 500));
+            REQUIRE_FALSE(bitmap.contains((u32{7} << 16) + 501));
+        }
+
+        WHEN("values are removed")
+        {
+            for(u32 i = 0; i < 20'000; i += 6)
+            {
+                REQUIRE(bitmap.remove(i));
+                expected.erase(i);
+            }
+
+            REQUIRE_FALSE(bitmap.remove(0));
+
+            THEN("the rest remain") { check(bitmap); }
+        }
+
+        WHEN("runs are optimized")
+        {
+            const auto before = bitmap.serialize().size();
+
+            bitmap.run_optimize();
+
+            THEN("contents are unchanged and serialized size shrinks")
+            {
+                check(bitmap);
+                REQUIRE(bitmap.serialize().size() < before);
+            }
+
+            AND_THEN("the bitmap can still be modified")
+            {
+                REQUIRE(bitmap.remove((u32{9} << 16) + 10));
+                expected.erase((u32{9} << 16) + 10);
+                check(bitmap);
+            }
+        }
+
+        THEN("serialization round trips")
+        {
+            const auto bytes = bitmap.serialize();
+
+            REQUIRE(roaring_bitmap::deserialize(bytes) == bitmap);
+            REQUIRE_THROWS_AS(
+                roaring_bitmap::deserialize(std::span{bytes}.first(bytes.size() - 1)),
+                std::invalid_argument
+            );
+        }
+
+        AND_GIVEN("another bitmap")
+        {
+            std::set<u32> other_values;
+
+            for(u32 i = 0; i < 30'000; i += 2) other_values.insert(i);
+            for(u32 i = 0; i < 10; ++i) other_values.insert((u32{9} << 16) + i * 10'000);
+
+            const roaring_bitmap other{other_values.begin(), other_values.end()};
+
+            THEN("union matches set union")
+            {
+                std::vector<u32> union_values;
+                std::ranges::set_union(expected, other_values, std::back_inserter(union_values));
+
+                REQUIRE(std::ranges::equal(bitmap | other, union_values));
+            }
+
+            THEN("intersection matches set intersection")
+            {
+                std::vector<u32> intersection;
+                std::ranges::set_intersection(
+                    expected,
+                    other_values,
+                    std::back_inserter(intersection)
+                );
+
+                bitmap.run_optimize();
+                bitmap &= other;
+
+                REQUIRE(std::ranges::equal(bitmap, intersection));
+            }
+        }
+    }
+}
+
+SCENARIO("roaring bitmap deserialization", "[bitset][roaring_bitmap]")
+{
+    // a single chunk with key 0 and the given container
+    const auto serialized = [](const u8 kind, const u32 size, const auto& elements)
+    {
+        std::vector<std::byte> bytes;
+
+        const auto write = [&bytes]<typename T>(const T value)
+        {
+            for(std::size_t i = 0; i < sizeof(T); ++i)
+                bytes.push_back(static_cast<std::byte>(value >> (i * 8)));
+        };
+
+        write(u32{1});
+        write(u16{0});
+        write(kind);
+        write(size);
+        for(const auto element : elements) write(element);
+
+        return bytes;
+    };
+
+    const auto malformed = [](const std::vector<std::byte>& bytes)
+    {
+        REQUIRE_THROWS_AS(roaring_bitmap::deserialize(bytes), std::invalid_argument);
+    };
+
+    GIVEN("a well formed array container")
+    {
+        auto bytes = serialized(0, 3, std::vector<u16>{1, 2, 3});
+
+        THEN("it deserializes") { REQUIRE(roaring_bitmap::deserialize(bytes).size() == 3); }
+
+        THEN("trailing bytes are rejected")
+        {
+            bytes.push_back(std::byte{0});
+            malformed(bytes);
+        }
+    }
+
+    THEN("unordered or repeated array values are rejected")
+    {
+        malformed(serialized(0, 3, std::vector<u16>{1, 3, 2}));
+        malformed(serialized(0, 3, std::vector<u16>{1, 1, 2}));
+    }
+
+    THEN("array containers above 4096 values are rejected")
+    {
+        std::vector<u16> values(4097);
+        std::iota(values.begin(), values.end(), u16{0});
+
+        malformed(serialized(0, 4097, values));
+    }
+
+    THEN("bitmap containers with at most 4096 values are rejected")
+    {
+        std::vector<u64> words(1024);
+        words.front() = ~u64{0};
+
+        malformed(serialized(1, 1024, words));
+    }
+
+    GIVEN("run containers")
+    {
+        THEN("ascending disjoint runs deserialize")
+        {
+            REQUIRE(roaring_bitmap::deserialize(serialized(2, 2, std::vector<u16>{10, 5, 16, 1}))
+                        .size() == 8);
+        }
+
+        THEN("descending or overlapping runs are rejected")
+        {
+            malformed(serialized(2, 2, std::vector<u16>{20, 1, 10, 1}));
+            malformed(serialized(2, 2, std::vector<u16>{10, 5, 15, 1}));
+        }
+
+        THEN("runs past the end of the chunk are rejected")
+        {
+            malformed(serialized(2, 1, std::vector<u16>{0xFFF0, 0x10}));
+        }
+    }
+}
@@ -0,0 +1,100 @@
+#include "stdsharp/concurrent_lazy.h"
+#include "test.h"
+
+#include <thread>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("concurrent lazy", "[concurrent_lazy]")
+{
+    STATIC_REQUIRE(!movable<concurrent_lazy<string (*)()>>);
+
+    GIVEN("a concurrent lazy value")
+    {
+        atomic_size_t invoked{};
+        concurrent_lazy lazy{[&invoked]
+                             {
+                                 ++invoked;
+                                 return string{"foo"};
+                             }};
+
+        WHEN("get value from multiple threads")
+        {
+            atomic_size_t matched{};
+
+            {
+                vector<jthread> threads;
+
+                for(auto i = 0; i < 8; ++i)
+                    threads.emplace_back([&] { matched += lazy.get() == "foo" ? 1 : 0; });
+            }
+
+            THEN("initializer is invoked only once")
+            {
+                REQUIRE(matched == 8);
+                REQUIRE(invoked == 1);
+                REQUIRE(lazy.has_value());
+                REQUIRE(lazy.cget() == "foo");
+            }
+        }
+    }
+
+    GIVEN("a concurrent lazy value that throws on first try")
+    {
+        auto first = true;
+        concurrent_lazy lazy{[&first]
+                             {
+                                 if(first)
+                                 {
+                                     first = false;
+                                     throw runtime_error{"first"};
+                                 }
+
+                                 return 42;
+                             }};
+
+        WHEN("get value twice")
+        {
+            REQUIRE_THROWS_AS(lazy.get(), runtime_error);
+
+            THEN("the second call initializes the value") { REQUIRE(lazy.get() == 42); }
+        }
+    }
+
+    GIVEN("a concurrent lazy value whose move constructor throws")
+    {
+        struct throwing_move
+        {
+            throwing_move() = default;
+            throwing_move(const throwing_move&) = delete;
+
+            throwing_move(throwing_move&& /*unused*/) noexcept(false)
+            {
+                throw runtime_error{"move"};
+            }
+
+            throwing_move& operator=(const throwing_move&) = delete;
+            throwing_move& operator=(throwing_move&&) = delete;
+            ~throwing_move() = default;
+        };
+
+        auto invoked = 0;
+        concurrent_lazy lazy{[&invoked]
+                             {
+                                 ++invoked;
+                                 return throwing_move{};
+                             }};
+
+        WHEN("get value twice")
+        {
+            REQUIRE_THROWS_AS(lazy.get(), runtime_error);
+            REQUIRE_THROWS_AS(lazy.get(), runtime_error);
+
+            THEN("the initializer is not invoked again")
+            {
+                REQUIRE(invoked == 1);
+                REQUIRE_FALSE(lazy.has_value());
+            }
+        }
+    }
+}
@@ -90,6 +90,15 @@ TEMPLATE_TEST_CASE("Scenario: pop where actions", "[containers][actions]", vecto
     });
 }
 
+TEMPLATE_TEST_CASE("Scenario: try where actions", "[containers][actions]", deque<int>, list<int>)
+{
+    TestType v;
+
+    REQUIRE(actions::try_emplace_back(v, 1));
+    REQUIRE(actions::try_pop_front(v) == 1);
+    REQUIRE(!actions::try_pop_front(v));
+}
+
 TEMPLATE_TEST_CASE("Scenario: resize actions", "[containers][actions]", vector<int>, list<int>)
 {
     STATIC_REQUIRE(requires(TestType v) { actions::resize(v, 5); });
@@ -0,0 +1,128 @@
+#include "stdsharp/containers/concurrent_unordered_map.h"
+#include "test.h"
+
+#include <thread>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("concurrent unordered map", "[containers][concurrent_unordered_map]")
+{
+    using map = concurrent_unordered_map<int, string>;
+
+    STATIC_REQUIRE(unique_unordered_associative_container<map>);
+
+    GIVEN("a map with two elements")
+    {
+        map instance{{1, "1"}, {2, "2"}};
+
+        THEN("single-threaded view contains the elements")
+        {
+            REQUIRE(instance.size() == 2);
+            REQUIRE(std::ranges::distance(instance) == 2);
+            REQUIRE(instance.find(1)->second == "1");
+            REQUIRE(instance.find(3) == instance.end());
+        }
+
+        WHEN("find with callback")
+        {
+            string value;
+
+            REQUIRE(instance.find(2, [&value](const auto& pair) { value = pair.second; }));
+            REQUIRE(!instance.find(3, [](const auto&) {}));
+
+            THEN("value is visited") { REQUIRE(value == "2"); }
+        }
+
+        WHEN("insert or assign")
+        {
+            REQUIRE(!instance.insert_or_assign(1, "one"));
+            REQUIRE(instance.insert_or_assign(3, "3"));
+
+            THEN("existing value is assigned and new value is inserted")
+            {
+                REQUIRE(instance.find(1)->second == "one");
+                REQUIRE(instance.size() == 3);
+            }
+        }
+
+        WHEN("try emplace")
+        {
+            string value = "two";
+
+            REQUIRE(!instance.try_emplace(2, cpp_move(value)));
+            REQUIRE(instance.try_emplace(3, 3, '3'));
+
+            THEN("existing value and args are kept and new value is inserted")
+            {
+                REQUIRE(value == "two");
+                REQUIRE(instance.find(2)->second == "2");
+                REQUIRE(instance.find(3)->second == "333");
+            }
+        }
+
+        WHEN("erase if key is odd")
+        {
+            REQUIRE(erase_if(instance, [](const auto& pair) { return pair.first % 2 == 1; }) == 1);
+
+            THEN("only even key left") { REQUIRE(instance == map{{2, "2"}}); }
+        }
+
+        WHEN("extract and reinsert the node")
+        {
+            auto node = instance.extract(1);
+            const auto [position, inserted, _] = instance.insert(cpp_move(node));
+
+            THEN("node is inserted back")
+            {
+                REQUIRE(inserted);
+                REQUIRE(position->first == 1);
+                REQUIRE(instance.size() == 2);
+            }
+        }
+
+        THEN("buckets cover all elements")
+        {
+            size_t count = 0;
+            for(size_t i = 0; i < instance.bucket_count(); ++i) count += instance.bucket_size(i);
+            REQUIRE(count == 2);
+
+            const auto bucket = instance.bucket(1);
+            REQUIRE(std::ranges::distance(instance.begin(bucket), instance.end(bucket)) >= 1);
+        }
+    }
+
+    GIVEN("multiple threads modifying the map")
+    {
+        constexpr auto thread_count = 4;
+        constexpr auto key_count = 1'000;
+
+        concurrent_unordered_map<int, int> instance;
+
+        {
+            vector<jthread> threads;
+
+            for(auto i = 0; i < thread_count; ++i)
+                threads.emplace_back(
+                    [&instance, i]
+                    {
+                        for(auto key = 0; key < key_count; ++key)
+                        {
+                            instance.insert_or_assign(i * key_count + key, key);
+                            instance.find(key, [](const auto&) {});
+                        }
+
+                        instance.erase_if( //
+                            [i](const auto& pair) { return pair.first == i * key_count; }
+                        );
+                    }
+                );
+        }
+
+        THEN("all insertions are visible except erased ones")
+        {
+            REQUIRE(instance.size() == thread_count * key_count - thread_count);
+
+            for(auto i = 0; i < thread_count; ++i) REQUIRE(!instance.contains(i * key_count));
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include "stdsharp/containers/actions.h"
+#include "stdsharp/containers/mpmc_queue.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("mpmc queue", "[containers][mpmc_queue]")
+{
+    GIVEN("a queue with capacity 3")
+    {
+        mpmc_queue<string> queue{3};
+
+        THEN("capacity is rounded up to power of 2") { REQUIRE(queue.capacity() == 4); }
+
+        WHEN("fill the queue")
+        {
+            for(auto i = 0; i < 4; ++i) REQUIRE(queue.try_emplace_back(to_string(i)));
+
+            THEN("further push fails") { REQUIRE(!queue.try_emplace_back("4")); }
+
+            THEN("elements are popped in FIFO order")
+            {
+                for(auto i = 0; i < 4; ++i) REQUIRE(queue.try_pop_front() == to_string(i));
+                REQUIRE(!queue.try_pop_front());
+                REQUIRE(queue.empty());
+            }
+        }
+
+        WHEN("use actions CPOs")
+        {
+            REQUIRE(actions::try_emplace_back(queue, "foo"));
+
+            THEN("element can be popped") { REQUIRE(actions::try_pop_front(queue) == "foo"); }
+        }
+    }
+
+    GIVEN("a full queue of a type with a throwing constructor")
+    {
+        struct owner
+        {
+            unique_ptr<int> ptr;
+
+            explicit owner(unique_ptr<int>&& p) noexcept(false): ptr(cpp_move(p)) {}
+        };
+
+        mpmc_queue<owner> queue{2};
+
+        REQUIRE(queue.try_emplace_back(make_unique<int>(0)));
+        REQUIRE(queue.try_emplace_back(make_unique<int>(1)));
+
+        THEN("push fails and leaves args untouched")
+        {
+            auto ptr = make_unique<int>(2);
+
+            REQUIRE(!queue.try_emplace_back(cpp_move(ptr)));
+            REQUIRE(ptr != nullptr);
+        }
+    }
+
+    GIVEN("multiple producers and consumers")
+    {
+        constexpr auto producer_count = 4;
+        constexpr auto count_per_producer = 10'000;
+
+        mpmc_queue<int> queue{64};
+        atomic_size_t consumed{};
+        atomic<long long> sum{};
+
+        {
+            vector<jthread> threads;
+
+            for(auto p = 0; p < producer_count; ++p)
+                threads.emplace_back(
+                    [&]
+                    {
+                        for(auto i = 1; i <= count_per_producer; ++i)
+                            while(!queue.try_emplace_back(i)) this_thread::yield();
+                    }
+                );
+
+            for(auto c = 0; c < 4; ++c)
+                threads.emplace_back(
+                    [&]
+                    {
+                        while(consumed < producer_count * count_per_producer)
+                            if(const auto value = queue.try_pop_front(); value)
+                            {
+                                sum += *value;
+                                ++consumed;
+                            }
+                            else this_thread::yield();
+                    }
+                );
+        }
+
+        THEN("every element is consumed exactly once")
+        {
+            constexpr auto expected =
+                producer_count * (count_per_producer * (count_per_producer + 1LL) / 2);
+
+            REQUIRE(sum == expected);
+        }
+    }
+}
+
+TEST_CASE("mpmc queue throughput", "[.][benchmark][mpmc_queue]")
+{
+    constexpr auto item_count = 100'000;
+
+    const auto run = [](const int producers, const int consumers)
+    {
+        mpmc_queue<int> queue{1024};
+        atomic_int remaining{item_count};
+        const auto per_producer = item_count / producers;
+        vector<jthread> threads;
+
+        for(auto p = 0; p < producers; ++p)
+            threads.emplace_back(
+                [&queue, per_producer]
+                {
+                    for(auto i = 0; i < per_producer; ++i)
+                        while(!queue.try_emplace_back(i)) this_thread::yield();
+                }
+            );
+
+        for(auto c = 0; c < consumers; ++c)
+            threads.emplace_back(
+                [&]
+                {
+                    while(remaining.load(memory_order_relaxed) > 0)
+                        if(queue.try_pop_front()) --remaining;
+                }
+            );
+
+        return item_count;
+    };
+
+    BENCHMARK("1 producer 1 consumer") { return run(1, 1); };
+    BENCHMARK("2 producers 2 consumers") { return run(2, 2); };
+    BENCHMARK("4 producers 4 consumers") { return run(4, 4); };
+    BENCHMARK("8 producers 1 consumer") { return run(8, 1); };
+    BENCHMARK("1 producer 8 consumers") { return run(1, 8); };
+}
@@ -0,0 +1,84 @@
+#include "stdsharp/containers/actions.h"
+#include "stdsharp/containers/spsc_queue.h"
+#include "test.h"
+
+#include <numeric>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("spsc queue", "[containers][spsc_queue]")
+{
+    GIVEN("a queue with capacity 3")
+    {
+        spsc_queue<string> queue{3};
+        vector<string> in{"a", "b", "c", "d", "e"};
+        vector<string> out;
+
+        THEN("capacity is rounded up to power of 2") { REQUIRE(queue.capacity() == 4); }
+
+        WHEN("push more elements than capacity")
+        {
+            const auto [it, count] = queue.push_n(in.begin(), in.size());
+
+            THEN("only capacity elements are pushed")
+            {
+                REQUIRE(count == 4);
+                REQUIRE(it == in.begin() + 4);
+                REQUIRE(!queue.try_emplace_back("f"));
+            }
+
+            AND_WHEN("pop part of them and push across the end of the ring")
+            {
+                REQUIRE(queue.pop_n(back_inserter(out), 3).count == 3);
+                REQUIRE(queue.push_n(it, 1).count == 1);
+                REQUIRE(actions::try_emplace_back(queue, "f"));
+
+                THEN("elements are popped in FIFO order")
+                {
+                    REQUIRE(queue.pop_n(back_inserter(out), 10).count == 3);
+                    REQUIRE(out == vector<string>{"a", "b", "c", "d", "e", "f"});
+                    REQUIRE(!actions::try_pop_front(queue));
+                }
+            }
+        }
+    }
+
+    GIVEN("a producer and a consumer thread")
+    {
+        constexpr auto count = 100'000;
+        constexpr auto batch = 64;
+
+        spsc_queue<int> queue{256};
+        atomic_bool ordered = true;
+
+        {
+            jthread producer{
+                [&]
+                {
+                    array<int, batch> buffer{};
+                    for(auto next = 0; next < count;)
+                    {
+                        iota(buffer.begin(), buffer.end(), next);
+                        const auto n = static_cast<size_t>(std::min(batch, count - next));
+                        next += static_cast<int>(queue.push_n(buffer.begin(), n).count);
+                    }
+                }
+            };
+
+            jthread consumer{
+                [&]
+                {
+                    array<int, batch> buffer{};
+                    for(auto expected = 0; expected < count;)
+                    {
+                        const auto n = queue.pop_n(buffer.begin(), batch).count;
+                        for(size_t i = 0; i < n; ++i, ++expected)
+                            if(buffer[i] != expected) ordered = false;
+                    }
+                }
+            };
+        }
+
+        THEN("elements are received in order") { REQUIRE(ordered); }
+    }
+}
@@ -0,0 +1,153 @@
+#include "stdsharp/coroutine/async_synchronizer.h"
+#include "stdsharp/coroutine/task.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    template<typename Mutex>
+    task<> increase(Mutex& mutex, int& value, const int count)
+    {
+        for(auto i = 0; i < count; ++i)
+        {
+            const auto lock = co_await mutex.scoped_lock();
+            ++value;
+        }
+    }
+
+    template<typename Mutex>
+    task<> lock_and_set(Mutex& mutex, atomic_bool& flag)
+    {
+        co_await mutex.lock();
+        flag = true;
+        mutex.unlock();
+    }
+
+    task<int> read_value(const async_synchronizer<>& sync, const int& value)
+    {
+        const auto [v, lock] = co_await sync.read_with(value);
+        co_return v;
+    }
+
+    task<> write_value(const async_synchronizer<>& sync, int& value, const int count)
+    {
+        for(auto i = 0; i < count; ++i)
+        {
+            auto [v, lock] = co_await sync.write_with(value);
+            ++v;
+        }
+    }
+
+    template<typename Mutex>
+    void concurrent_increase_test()
+    {
+        constexpr auto thread_count = 8;
+        constexpr auto count = 1000;
+
+        Mutex mutex;
+        int value = 0;
+        {
+            vector<jthread> threads;
+            for(auto i = 0; i < thread_count; ++i)
+                threads.emplace_back([&] { sync_wait(increase(mutex, value, count)); });
+        }
+
+        REQUIRE(value == thread_count * count);
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Scenario: async mutex",
+    "[coroutine][async_mutex]",
+    async_mutex,
+    async_shared_mutex
+)
+{
+    GIVEN("a locked mutex")
+    {
+        TestType mutex;
+        atomic_bool flag{};
+
+        REQUIRE(mutex.try_lock());
+        REQUIRE(!mutex.try_lock());
+
+        WHEN("another coroutine waits for the mutex")
+        {
+            jthread waiter{[&] { sync_wait(lock_and_set(mutex, flag)); }};
+
+            THEN("it's resumed after unlock")
+            {
+                REQUIRE(!flag);
+                mutex.unlock();
+                waiter.join();
+                REQUIRE(flag);
+                REQUIRE(mutex.try_lock());
+                mutex.unlock();
+            }
+        }
+    }
+
+    GIVEN("many threads locking the mutex")
+    {
+        THEN("increments are not lost") { concurrent_increase_test<TestType>(); }
+    }
+}
+
+SCENARIO("async shared mutex", "[coroutine][async_shared_mutex]")
+{
+    GIVEN("a shared locked mutex")
+    {
+        async_shared_mutex mutex;
+
+        REQUIRE(mutex.try_lock_shared());
+
+        THEN("other readers can enter but writers can't")
+        {
+            REQUIRE(mutex.try_lock_shared());
+            REQUIRE(!mutex.try_lock());
+
+            mutex.unlock_shared();
+            mutex.unlock_shared();
+
+            REQUIRE(mutex.try_lock());
+            REQUIRE(!mutex.try_lock_shared());
+            mutex.unlock();
+        }
+
+        THEN("a waiting writer blocks later readers")
+        {
+            atomic_bool flag{};
+            jthread writer{[&] { sync_wait(lock_and_set(mutex, flag)); }};
+
+            while(mutex.try_lock_shared()) mutex.unlock_shared();
+
+            REQUIRE(!flag);
+            mutex.unlock_shared();
+            writer.join();
+            REQUIRE(flag);
+        }
+    }
+}
+
+SCENARIO("async synchronizer", "[coroutine][async_synchronizer]")
+{
+    GIVEN("a value guarded by async synchronizer")
+    {
+        const async_synchronizer<> sync;
+        int value = 0;
+
+        WHEN("write and read concurrently")
+        {
+            {
+                vector<jthread> threads;
+                for(auto i = 0; i < 4; ++i)
+                    threads.emplace_back([&] { sync_wait(write_value(sync, value, 1000)); });
+                for(auto i = 0; i < 4; ++i)
+                    threads.emplace_back([&] { sync_wait(read_value(sync, value)); });
+            }
+
+            THEN("no write is lost") { REQUIRE(sync_wait(read_value(sync, value)) == 4000); }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#include "stdsharp/coroutine/generator.h"
+#include "stdsharp/memory/soo.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    generator<int> iota_gen(const int n)
+    {
+        for(auto i = 0; i < n; ++i) co_yield i;
+    }
+
+    generator<int> countdown(const int depth)
+    {
+        co_yield depth;
+        if(depth != 0) co_yield elements_of(countdown(depth - 1));
+    }
+
+    generator<string> copy_strings()
+    {
+        string str = "foo";
+        co_yield str;
+        co_yield cpp_move(str);
+    }
+
+    generator<int> vector_elements()
+    {
+        vector vec{1, 2};
+        co_yield elements_of(vec);
+        co_yield elements_of(vector<int>(2, 3));
+    }
+
+    generator<int> throw_after_first()
+    {
+        co_yield 1;
+        throw std::runtime_error{"error"};
+    }
+
+    generator<int> nested_throw()
+    {
+        co_yield elements_of(throw_after_first());
+        co_yield 2;
+    }
+
+    generator<int> allocated_iota(allocator_arg_t /*unused*/, const auto& /*unused*/, const int n)
+    {
+        co_yield elements_of(iota_gen(n));
+    }
+}
+
+SCENARIO("generator", "[coroutine][generator]")
+{
+    STATIC_REQUIRE(std::ranges::input_range<generator<int>>);
+    STATIC_REQUIRE(std::ranges::view<generator<int>>);
+
+    GIVEN("a generator of integers")
+    {
+        THEN("values are yielded in order")
+        {
+            REQUIRE(std::ranges::equal(iota_gen(4), vector{0, 1, 2, 3}));
+        }
+
+        THEN("it composes with range adaptors")
+        {
+            REQUIRE(std::ranges::equal(
+                iota_gen(100) | views::filter([](const int i) { return i % 2 == 1; }) |
+                    views::take(3),
+                vector{1, 3, 5}
+            ));
+        }
+    }
+
+    GIVEN("recursively nested generators")
+    {
+        constexpr auto depth = 1000;
+
+        THEN("all nested values are yielded")
+        {
+            vector<int> values;
+            for(const auto i : countdown(depth)) values.push_back(i);
+
+            REQUIRE(values.size() == depth + 1);
+            REQUIRE(values.front() == depth);
+            REQUIRE(values.back() == 0);
+        }
+    }
+
+    GIVEN("a generator yielding lvalue and rvalue strings")
+    {
+        THEN("lvalue is copied")
+        {
+            vector<string> values;
+            for(auto&& str : copy_strings()) values.push_back(cpp_move(str));
+
+            REQUIRE(values == vector<string>{"foo", "foo"});
+        }
+    }
+
+    GIVEN("a generator yielding elements of vectors")
+    {
+        THEN("elements are yielded in order")
+        {
+            REQUIRE(std::ranges::equal(vector_elements(), vector{1, 2, 3, 3}));
+        }
+    }
+
+    GIVEN("a nested generator throwing exception")
+    {
+        THEN("exception propagates through the enclosing generator")
+        {
+            vector<int> values;
+
+            REQUIRE_THROWS_AS(
+                [&]
+                {
+                    for(const auto i : nested_throw()) values.push_back(i);
+                }(),
+                std::runtime_error
+            );
+            REQUIRE(values == vector{1});
+        }
+    }
+
+    GIVEN("a generator with allocator argument")
+    {
+        fixed_single_resource<1024> buffer;
+
+        THEN("frame is allocated from the allocator")
+        {
+            {
+                auto gen = allocated_iota(allocator_arg, make_soo_allocator(buffer), 3);
+
+                REQUIRE(!buffer.contains(nullptr));
+                REQUIRE(std::ranges::equal(gen, vector{0, 1, 2}));
+            }
+
+            REQUIRE(buffer.contains(nullptr));
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "stdsharp/coroutine/task.h"
+#include "stdsharp/memory/soo.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    task<int> answer() { co_return 42; }
+
+    task<int> add_answer(const int value) { co_return value + co_await answer(); }
+
+    task<> throw_error()
+    {
+        throw std::runtime_error{"error"};
+        co_return;
+    }
+
+    task<int&> ref_of(int& value) { co_return value; }
+
+    task<int> allocated_answer(allocator_arg_t /*unused*/, const auto& /*unused*/)
+    {
+        co_return co_await answer();
+    }
+}
+
+SCENARIO("task", "[coroutine][task]")
+{
+    GIVEN("a task awaiting another task")
+    {
+        auto t = add_answer(1);
+
+        THEN("it's lazily started")
+        {
+            REQUIRE(t.valid());
+            REQUIRE(!t.done());
+        }
+
+        THEN("sync wait returns the result") { REQUIRE(sync_wait(cpp_move(t)) == 43); }
+    }
+
+    GIVEN("a task returning reference")
+    {
+        int value = 0;
+
+        THEN("result refers to the same object")
+        {
+            REQUIRE(&sync_wait(ref_of(value)) == &value);
+        }
+    }
+
+    GIVEN("a task throwing exception")
+    {
+        THEN("exception is rethrown when awaited")
+        {
+            REQUIRE_THROWS_AS(sync_wait(throw_error()), std::runtime_error);
+        }
+    }
+
+    GIVEN("a task with allocator argument")
+    {
+        fixed_single_resource<1024> buffer;
+        const auto alloc = make_soo_allocator(buffer);
+
+        THEN("frame is allocated from the allocator")
+        {
+            {
+                auto t = allocated_answer(allocator_arg, alloc);
+
+                REQUIRE(!buffer.contains(nullptr));
+                REQUIRE(sync_wait(cpp_move(t)) == 42);
+            }
+
+            REQUIRE(buffer.contains(nullptr));
+        }
+    }
+}
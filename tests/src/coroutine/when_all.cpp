@@ -0,0 +1,105 @@
+#include "stdsharp/coroutine/schedule.h"
+#include "stdsharp/coroutine/when_all.h"
+#include "stdsharp/execution/thread_pool.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    task<int> value_of(const int value) { co_return value; }
+
+    task<> increase(atomic_int& count)
+    {
+        ++count;
+        co_return;
+    }
+
+    task<int> value_on(thread_pool& pool, const int value)
+    {
+        co_await schedule_on(pool);
+        co_return value;
+    }
+
+    task<int> never_ready(std::coroutine_handle<>& suspended)
+    {
+        struct suspend
+        {
+            std::coroutine_handle<>& handle;
+
+            [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+            void await_suspend(const std::coroutine_handle<> h) const noexcept { handle = h; }
+
+            static constexpr void await_resume() noexcept {}
+        };
+
+        co_await suspend{suspended};
+        co_return 0;
+    }
+}
+
+SCENARIO("when all", "[coroutine][when_all]")
+{
+    GIVEN("tasks with values and void")
+    {
+        atomic_int count{};
+
+        THEN("results are collected in order")
+        {
+            const auto [a, b, c] = sync_wait(when_all(value_of(1), increase(count), value_of(2)));
+
+            REQUIRE(a == 1);
+            REQUIRE(c == 2);
+            REQUIRE(count == 1);
+        }
+    }
+
+    GIVEN("tasks running on a thread pool")
+    {
+        thread_pool pool{4};
+
+        THEN("all tasks complete")
+        {
+            const auto [a, b] = sync_wait(when_all(value_on(pool, 1), value_on(pool, 2)));
+
+            REQUIRE(a + b == 3);
+        }
+    }
+}
+
+SCENARIO("when any", "[coroutine][when_any]")
+{
+    GIVEN("a task that completes and a task that doesn't")
+    {
+        std::coroutine_handle<> suspended;
+
+        THEN("result of the completed task is returned")
+        {
+            const auto result = sync_wait(when_any(never_ready(suspended), value_of(1)));
+
+            REQUIRE(result.index() == 1);
+            REQUIRE(std::get<1>(result) == 1);
+
+            suspended.resume();
+        }
+    }
+}
+
+SCENARIO("start on", "[coroutine][schedule]")
+{
+    GIVEN("a thread pool")
+    {
+        thread_pool pool{2};
+
+        THEN("task is resumed on a pool thread")
+        {
+            const auto id = sync_wait(start_on(
+                pool,
+                []() -> task<std::thread::id> { co_return std::this_thread::get_id(); }()
+            ));
+
+            REQUIRE(id != std::this_thread::get_id());
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#include "stdsharp/execution/chase_lev_deque.h"
+#include "test.h"
+
+#include <thread>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("chase lev deque", "[execution][chase_lev_deque]")
+{
+    GIVEN("a deque with small capacity")
+    {
+        chase_lev_deque<int> deque{2};
+
+        WHEN("push more values than capacity")
+        {
+            for(auto i = 0; i < 10; ++i) deque.push(i);
+
+            THEN("owner pops in lifo order and thieves steal in fifo order")
+            {
+                REQUIRE(deque.size() == 10);
+                REQUIRE(deque.pop() == 9);
+                REQUIRE(deque.steal() == 0);
+                REQUIRE(deque.size() == 8);
+            }
+        }
+
+        WHEN("pop from empty deque")
+        {
+            THEN("nothing is returned")
+            {
+                REQUIRE(!deque.pop());
+                REQUIRE(!deque.steal());
+                REQUIRE(deque.empty());
+            }
+        }
+    }
+
+    GIVEN("an owner racing with thieves")
+    {
+        constexpr auto count = 100'000;
+        chase_lev_deque<int> deque;
+        atomic_bool done{};
+        atomic<long long> sum{};
+
+        {
+            vector<jthread> thieves;
+
+            for(auto i = 0; i < 3; ++i)
+                thieves.emplace_back(
+                    [&]
+                    {
+                        while(!done.load() || !deque.empty())
+                            if(const auto v = deque.steal(); v) sum += *v;
+                    }
+                );
+
+            for(auto i = 1; i <= count; ++i)
+            {
+                deque.push(i);
+                if(i % 3 == 0)
+                    if(const auto v = deque.pop(); v) sum += *v;
+            }
+
+            while(const auto v = deque.pop()) sum += *v;
+
+            done = true;
+        }
+
+        THEN("every value is taken exactly once")
+        {
+            REQUIRE(sum == static_cast<long long>(count) * (count + 1) / 2);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include "stdsharp/execution/parallel_policy.h"
+#include "stdsharp/execution/thread_pool.h"
+#include "test.h"
+
+#include <stdexcept>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("parallel policy", "[execution][parallel_policy]")
+{
+    thread_pool pool{4};
+
+    GIVEN("a policy with at most 4 chunks of at least 10 elements")
+    {
+        const parallel_policy policy{pool, 4, 10};
+
+        THEN("chunk count is bounded")
+        {
+            REQUIRE(policy.chunk_count(0) == 1);
+            REQUIRE(policy.chunk_count(25) == 3);
+            REQUIRE(policy.chunk_count(1000) == 4);
+        }
+
+        WHEN("run chunks over 1000 indices")
+        {
+            vector<atomic_size_t> visited(1000);
+            vector<size_t> chunks(policy.chunk_count(visited.size()));
+
+            policy.for_each_chunk(
+                visited.size(),
+                [&](const size_t first, const size_t last, const size_t index)
+                {
+                    chunks[index] = last - first;
+                    for(auto i = first; i < last; ++i) ++visited[i];
+                }
+            );
+
+            THEN("every index is visited exactly once")
+            {
+                REQUIRE(std::ranges::all_of(visited, [](const auto& v) { return v == 1; }));
+                REQUIRE(std::ranges::all_of(chunks, [](const auto size) { return size == 250; }));
+            }
+        }
+
+        THEN("exception from a chunk is rethrown")
+        {
+            REQUIRE_THROWS_AS(
+                policy.for_each_chunk(
+                    100,
+                    [](const size_t first, const size_t, const size_t)
+                    {
+                        if(first > 0) throw runtime_error{"chunk"};
+                    }
+                ),
+                runtime_error
+            );
+        }
+    }
+}
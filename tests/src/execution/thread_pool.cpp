@@ -0,0 +1,59 @@
+#include "stdsharp/execution/thread_pool.h"
+#include "stdsharp/functional/invocables.h"
+#include "stdsharp/functional/sequenced_invocables.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("thread pool", "[execution][thread_pool]")
+{
+    GIVEN("a thread pool")
+    {
+        thread_pool pool{4};
+        atomic_size_t count{};
+
+        REQUIRE(pool.size() == 4);
+
+        WHEN("post tasks from outside the pool")
+        {
+            for(auto i = 0; i < 1000; ++i) pool.post([&count] { ++count; });
+            pool.wait();
+
+            THEN("every task is executed") { REQUIRE(count == 1000); }
+        }
+
+        WHEN("post tasks from inside the pool")
+        {
+            for(auto i = 0; i < 10; ++i)
+                pool(
+                    [&]
+                    {
+                        for(auto j = 0; j < 100; ++j) pool([&count] { ++count; });
+                    }
+                );
+            pool.wait();
+
+            THEN("nested tasks are executed") { REQUIRE(count == 1000); }
+        }
+
+        WHEN("post a task larger than the small buffer")
+        {
+            array<size_t, 16> values{};
+            values.back() = 42;
+
+            pool.post([&count, values] { count += values.back(); });
+            pool.wait();
+
+            THEN("the task is executed") { REQUIRE(count == 42); }
+        }
+
+        WHEN("post invocables and sequenced invocables")
+        {
+            pool.post(invocables{[&count] { ++count; }, [](int) {}});
+            pool.post(sequenced_invocables{[](int) {}, [&count] { ++count; }});
+            pool.wait();
+
+            THEN("the invocable overload is executed") { REQUIRE(count == 2); }
+        }
+    }
+}
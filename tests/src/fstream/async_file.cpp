@@ -0,0 +1,266 @@
+#include "stdsharp/execution/thread_pool.h"
+#include "stdsharp/fstream/async_file.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    auto write_file(const size_t size)
+    {
+        auto path = std::filesystem::temp_directory_path() / "stdsharp_async_file.bin";
+        std::ofstream fs{path, std::ios::binary};
+
+        for(size_t i = 0; i < size; ++i) fs.put(static_cast<char>(i * 31 % 251));
+
+        return path;
+    }
+
+    bool matches(const std::span<const std::byte> bytes, const size_t offset)
+    {
+        for(size_t i = 0; i < bytes.size(); ++i)
+            if(bytes[i] != static_cast<std::byte>((offset + i) * 31 % 251)) return false;
+        return true;
+    }
+
+    task<size_t> read_both(
+        io_ring<thread_pool>& ring,
+        const async_file& file,
+        const std::span<std::byte> first,
+        const std::span<std::byte> second
+    )
+    {
+        const auto size = co_await ring.async_read(file, first, 0);
+        co_return size + co_await ring.async_read(file, second, 1000);
+    }
+
+    void check_reads(io_ring<thread_pool>& ring, const async_file& file, const size_t file_size)
+    {
+        WHEN("more reads than ring entries are queued")
+        {
+            vector<std::array<std::byte, 64>> buffers(100);
+            size_t completed = 0;
+
+            for(size_t i = 0; i < buffers.size(); ++i)
+                ring.read(
+                    file,
+                    buffers[i],
+                    i * 97,
+                    [&, i](const std::error_code error, const size_t size)
+                    {
+                        REQUIRE(!error);
+                        REQUIRE(size == 64);
+                        REQUIRE(matches(buffers[i], i * 97));
+                        ++completed;
+                    }
+                );
+
+            THEN("they are submitted in batches and all complete")
+            {
+                REQUIRE(ring.outstanding() == buffers.size());
+                REQUIRE(ring.run() == buffers.size());
+                REQUIRE(completed == buffers.size());
+                REQUIRE(ring.outstanding() == 0);
+            }
+        }
+
+        WHEN("a read crosses the end of file")
+        {
+            std::array<std::byte, 100> buffer{};
+            size_t read = 0;
+
+            ring.read(
+                file,
+                buffer,
+                file_size - 10,
+                [&read](const std::error_code /*unused*/, const size_t size) { read = size; }
+            );
+            ring.run();
+
+            THEN("it is short") { REQUIRE(read == 10); }
+        }
+
+        WHEN("reads go to registered buffers")
+        {
+            vector<std::byte> storage(4 * 256);
+            vector<std::span<std::byte>> buffers;
+
+            for(size_t i = 0; i < 4; ++i)
+                buffers.push_back(std::span{storage}.subspan(i * 256, 256));
+
+            // only io_uring registers them, though the kernel may still refuse to pin them
+            const auto registered = ring.register_buffers(buffers);
+
+            REQUIRE((ring.uses_io_uring() || !registered));
+
+            size_t completed = 0;
+
+            for(size_t i = 0; i < buffers.size(); ++i)
+                ring.read_fixed(
+                    file,
+                    i,
+                    i * 500,
+                    256,
+                    [&, i](const std::error_code error, const size_t size)
+                    {
+                        REQUIRE(!error);
+                        REQUIRE(size == 256);
+                        REQUIRE(matches(ring.buffer(i), i * 500));
+                        ++completed;
+                    }
+                );
+            ring.run();
+            ring.unregister_buffers();
+
+            THEN("every buffer is filled") { REQUIRE(completed == buffers.size()); }
+        }
+
+        WHEN("a coroutine awaits reads")
+        {
+            std::array<std::byte, 50> first{};
+            std::array<std::byte, 50> second{};
+
+            const auto size = ring.sync_wait(read_both(ring, file, first, second));
+
+            THEN("it resumes with the results")
+            {
+                REQUIRE(size == 100);
+                REQUIRE(matches(first, 0));
+                REQUIRE(matches(second, 1000));
+            }
+        }
+    }
+}
+
+SCENARIO("async file", "[fstream][async_file]")
+{
+    constexpr size_t file_size = 1 << 16;
+
+    thread_pool pool{4};
+    const async_file file{write_file(file_size)};
+
+    GIVEN("a ring preferring io_uring")
+    {
+        io_ring ring{pool, 8};
+
+        check_reads(ring, file, file_size);
+    }
+
+    GIVEN("a ring running reads on the executor")
+    {
+        io_ring ring{pool, 8, false};
+
+        REQUIRE_FALSE(ring.uses_io_uring());
+
+        check_reads(ring, file, file_size);
+    }
+
+#if __has_include(<linux/io_uring.h>)
+    GIVEN("a pipe written in pieces")
+    {
+        io_ring ring{pool, 8};
+        std::array<int, 2> fds{};
+
+        REQUIRE(::pipe(fds.data()) == 0);
+
+        // reopens the read end, which stays open so the writer never sees a closed pipe
+        const async_file pipe{"/proc/self/fd/" + to_string(fds[0])};
+
+        jthread writer{
+            [fd = fds[1]]
+            {
+                for(char c = 'a'; c < 'e'; ++c)
+                {
+                    std::array<char, 10> piece{};
+
+                    piece.fill(c);
+                    this_thread::sleep_for(10ms);
+                    [[maybe_unused]] const auto written = ::write(fd, piece.data(), piece.size());
+                }
+            }
+        };
+
+        // pread cannot read pipes, so only io_uring is exercised
+        if(ring.uses_io_uring())
+        {
+            WHEN("a read asks for every piece")
+            {
+                std::array<char, 40> buffer{};
+                size_t read = 0;
+
+                ring.read(
+                    pipe,
+                    std::as_writable_bytes(std::span{buffer}),
+                    0,
+                    [&read](const std::error_code /*unused*/, const size_t size) { read = size; }
+                );
+                ring.run();
+
+                THEN("short reads are resubmitted until the buffer is full")
+                {
+                    REQUIRE(read == buffer.size());
+                    REQUIRE(
+                        string_view{buffer.data(), buffer.size()} ==
+                        "aaaaaaaaaabbbbbbbbbbccccccccccdddddddddd"
+                    );
+                }
+            }
+        }
+
+        writer.join();
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+#endif
+
+    GIVEN("a missing file")
+    {
+        THEN("opening throws")
+        {
+            REQUIRE_THROWS_AS(
+                async_file{std::filesystem::temp_directory_path() / "stdsharp_missing.bin"},
+                std::filesystem::filesystem_error
+            );
+        }
+    }
+}
+
+TEST_CASE("async file benchmark", "[.][benchmark][fstream]")
+{
+    constexpr size_t file_size = 1 << 24;
+    constexpr size_t read_count = 256;
+
+    thread_pool pool;
+    const async_file file{write_file(file_size)};
+    vector<std::array<std::byte, 4096>> buffers(read_count);
+
+    const auto random_reads = [&](io_ring<thread_pool>& ring)
+    {
+        size_t total = 0;
+
+        for(size_t i = 0; i < read_count; ++i)
+            ring.read(
+                file,
+                buffers[i],
+                (i * 7919 % (file_size / 4096)) * 4096,
+                [&total](const std::error_code /*unused*/, const size_t size) { total += size; }
+            );
+        ring.run();
+
+        return total;
+    };
+
+    io_ring uring{pool, read_count};
+    io_ring fallback{pool, read_count, false};
+
+    BENCHMARK("io_uring") { return random_reads(uring); };
+
+    BENCHMARK("executor") { return random_reads(fallback); };
+}
@@ -0,0 +1,138 @@
+#include "stdsharp/fstream/binary_records.h"
+#include "stdsharp/fstream/fstream.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <numeric>
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    struct point
+    {
+        int x;
+        float y;
+        double z;
+
+        bool operator==(const point&) const = default;
+    };
+}
+
+SCENARIO("binary records", "[fstream][binary_records]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "stdsharp_binary_records.bin";
+
+    GIVEN("records written with a small buffer")
+    {
+        vector<point> points;
+
+        for(auto i = 0; i < 100; ++i) points.push_back({i, i * 0.5F, i * 0.25});
+
+        {
+            record_writer<point> writer{path, std::ios::trunc, 5 * sizeof(point)};
+
+            writer.write(points.front());
+            writer.write(std::span{points}.subspan(1, 3));
+            writer.write(std::span{points}.subspan(4));
+            writer.flush();
+        }
+
+        THEN("they are viewed in place")
+        {
+            const auto records = map_records<point>(path);
+
+            REQUIRE(records.size() == points.size());
+            REQUIRE(std::ranges::equal(records, points));
+            REQUIRE(records[42] == points[42]);
+        }
+
+        WHEN("more records are appended")
+        {
+            {
+                record_writer<point> writer{path, std::ios::app};
+                writer.write(point{-1, 0, 0});
+            }
+
+            THEN("they follow the previous ones")
+            {
+                const mapped_records<point> records{path};
+
+                REQUIRE(records.size() == points.size() + 1);
+                REQUIRE(records.records().back().x == -1);
+            }
+        }
+    }
+
+    GIVEN("a file with a header before the records")
+    {
+        {
+            record_writer<int> writer{path};
+            writer.write(vector{7, 1, 2, 3});
+        }
+
+        THEN("records start at the offset")
+        {
+            REQUIRE(std::ranges::equal(map_records<int>(path, sizeof(int)), vector{1, 2, 3}));
+        }
+
+        THEN("truncated records are rejected")
+        {
+            REQUIRE_THROWS_AS(map_records<int>(path, 2), std::filesystem::filesystem_error);
+            REQUIRE_THROWS_AS(map_records<long long>(path, 4), std::filesystem::filesystem_error);
+            REQUIRE_THROWS_AS(map_records<int>(path, 100), std::filesystem::filesystem_error);
+        }
+    }
+
+    GIVEN("a one byte header")
+    {
+        {
+            record_writer<char> writer{path};
+            writer.write(string(1 + sizeof(long long), 'a'));
+        }
+
+        THEN("misaligned records are rejected")
+        {
+            REQUIRE_THROWS_AS(map_records<long long>(path, 1), std::filesystem::filesystem_error);
+        }
+    }
+
+    GIVEN("an empty file")
+    {
+        {
+            const std::ofstream fs{path, std::ios::binary};
+        }
+
+        THEN("there are no records") { REQUIRE(map_records<point>(path).empty()); }
+    }
+}
+
+TEST_CASE("binary records benchmark", "[.][benchmark][fstream]")
+{
+    const auto binary_path = std::filesystem::temp_directory_path() / "stdsharp_records.bin";
+    const auto text_path = std::filesystem::temp_directory_path() / "stdsharp_records.txt";
+    vector<long long> values(1'000'000);
+
+    std::iota(values.begin(), values.end(), 0);
+
+    {
+        record_writer<long long> writer{binary_path};
+        std::ofstream fs{text_path};
+
+        writer.write(values);
+        for(const auto value : values) fs << value << ' ';
+    }
+
+    BENCHMARK("map_records")
+    {
+        const auto records = map_records<long long>(binary_path);
+        return std::reduce(records.begin(), records.end());
+    };
+
+    BENCHMARK("read_all")
+    {
+        const auto records = read_all<long long>(text_path);
+        return std::reduce(records.begin(), records.end());
+    };
+}
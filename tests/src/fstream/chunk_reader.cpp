@@ -0,0 +1,70 @@
+#include "stdsharp/fstream/chunk_reader.h"
+#include "test.h"
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("chunk reader", "[fstream][chunk_reader]")
+{
+    STATIC_REQUIRE(std::ranges::input_range<decltype(read_chunks({}))>);
+    STATIC_REQUIRE(std::ranges::view<decltype(read_records({}))>);
+
+    const auto path = std::filesystem::temp_directory_path() / "stdsharp_chunk_reader.txt";
+
+    GIVEN("a file of lines")
+    {
+        const string content = "alpha\nbeta\n\na line longer than a chunk\nlast";
+
+        {
+            std::ofstream fs{path, std::ios::binary};
+            fs << content;
+        }
+
+        THEN("chunks concatenate to the file")
+        {
+            string joined;
+
+            for(const auto chunk : read_chunks(path, 4))
+            {
+                REQUIRE(chunk.size() <= 4);
+                joined.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+            }
+
+            REQUIRE(joined == content);
+        }
+
+        THEN("records are split on the delimiter")
+        {
+            vector<string> records;
+
+            for(const auto record : read_records(path, '\n', 4)) records.emplace_back(record);
+
+            REQUIRE(
+                records ==
+                vector<string>{"alpha", "beta", "", "a line longer than a chunk", "last"}
+            );
+        }
+
+        THEN("records compose with range adaptors")
+        {
+            size_t count = 0;
+
+            for([[maybe_unused]] const auto record :
+                read_records(path) |
+                    views::filter([](const std::string_view record) { return !record.empty(); }))
+                ++count;
+
+            REQUIRE(count == 4);
+        }
+    }
+
+    GIVEN("a missing file")
+    {
+        std::filesystem::remove(path);
+
+        THEN("iteration throws")
+        {
+            auto chunks = read_chunks(path);
+            REQUIRE_THROWS_AS(chunks.begin(), std::filesystem::filesystem_error);
+        }
+    }
+}
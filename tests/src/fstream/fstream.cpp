@@ -0,0 +1,135 @@
+#include "stdsharp/fstream/fstream.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <limits>
+#include <list>
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    auto write_file(const string& content)
+    {
+        auto path = std::filesystem::temp_directory_path() / "stdsharp_read_all.txt";
+        std::ofstream fs{path, std::ios::binary};
+        fs << content;
+        return path;
+    }
+}
+
+SCENARIO("read all", "[fstream]")
+{
+    GIVEN("a file of whitespace separated integers")
+    {
+        const auto path = write_file("1 2\n3\t+4\n-5 \n");
+
+        THEN("all integers are read")
+        {
+            REQUIRE(read_all<int>(path) == vector{1, 2, 3, 4, -5});
+
+            list<long> values;
+            REQUIRE(read_all_to_container<long>(values, path) == list<long>{1, 2, 3, 4, -5});
+        }
+    }
+
+    GIVEN("a file of floating point values")
+    {
+        const auto path = write_file("1.5 2e3 -0.25");
+
+        THEN("all values are read") { REQUIRE(read_all<double>(path) == vector{1.5, 2e3, -0.25}); }
+    }
+
+    GIVEN("a file with a token that is not a number")
+    {
+        const auto path = write_file("1 2 x 4");
+
+        THEN("reading stops at the token") { REQUIRE(read_all<int>(path) == vector{1, 2}); }
+    }
+
+    GIVEN("a file with a token longer than a read chunk")
+    {
+        const auto path = write_file(string(3'000'000, '0') + "5 6");
+
+        THEN("the token is parsed whole") { REQUIRE(read_all<int>(path) == vector{5, 6}); }
+    }
+
+    GIVEN("a file with a token crossing the end of the first read chunk")
+    {
+        string content;
+
+        // 2^19 - 3 ones take 2^20 - 6 bytes, the next token starts 6 bytes before the chunk end
+        for(auto i = 0; i < (1 << 19) - 3; ++i) content += "1 ";
+
+        const auto path = write_file(content + "123456789012 7");
+
+        THEN("the token is carried over to the next chunk")
+        {
+            const auto values = read_all<long long>(path);
+
+            REQUIRE(values.size() == (size_t{1} << 19) - 1);
+            REQUIRE(values[values.size() - 2] == 123'456'789'012);
+            REQUIRE(values.back() == 7);
+        }
+    }
+
+    GIVEN("a file with a negative value of an unsigned type and trailing whitespace")
+    {
+        const auto path = write_file("1 -5 2\n");
+
+        THEN("reading the path or the stream stops at the negative value")
+        {
+            std::ifstream fs{path};
+
+            REQUIRE(read_all<unsigned>(path) == vector{1U});
+            REQUIRE(read_all<unsigned>(fs) == vector{1U});
+        }
+    }
+
+    GIVEN("a file starting with infinity")
+    {
+        const auto path = write_file("inf +2 \n");
+
+        THEN("reading the path or the stream accepts it")
+        {
+            const vector expected{numeric_limits<double>::infinity(), 2.0};
+            std::ifstream fs{path};
+
+            REQUIRE(read_all<double>(path) == expected);
+            REQUIRE(read_all<double>(fs) == expected);
+        }
+    }
+
+    GIVEN("a text file")
+    {
+        const auto path = write_file("ab cd");
+
+        THEN("non arithmetic values are read by operator>>")
+        {
+            REQUIRE(read_all<string>(path).front() == "ab");
+            REQUIRE(read_all_text(path) == "ab cd");
+        }
+    }
+}
+
+TEST_CASE("read all benchmark", "[.][benchmark][fstream]")
+{
+    string content;
+
+    for(auto i = 0; i < 1'000'000; ++i) content += std::to_string(i * 7919) + ' ';
+
+    const auto path = write_file(content);
+
+    BENCHMARK("from_chars") { return read_all<long long>(path); };
+
+    BENCHMARK("operator>>")
+    {
+        std::ifstream fs{path};
+        vector<long long> values;
+
+        for(long long value{}; fs >> value;) values.push_back(value);
+
+        return values;
+    };
+}
@@ -0,0 +1,123 @@
+#include "stdsharp/fstream/mapped_file.h"
+#include "test.h"
+
+#include <fstream>
+#include <thread>
+
+#if __has_include(<sys/stat.h>)
+    #include <sys/stat.h>
+#endif
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("mapped file", "[fstream][mapped_file]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "stdsharp_mapped_file.txt";
+
+    GIVEN("a file with text")
+    {
+        const string content = "first line\nsecond line\n";
+
+        {
+            std::ofstream fs{path, std::ios::binary};
+            fs << content;
+        }
+
+        mapped_file file{path};
+
+        THEN("contents are viewed without copying")
+        {
+            REQUIRE(file.text() == content);
+            REQUIRE(file.bytes().size() == content.size());
+            REQUIRE(static_cast<char>(file.bytes().front()) == 'f');
+        }
+
+        WHEN("file is moved")
+        {
+            mapped_file other = cpp_move(file);
+
+            THEN("the view moves with it")
+            {
+                REQUIRE(file.empty());
+                REQUIRE(other.text() == content);
+            }
+        }
+
+        THEN("access hints only apply to mappings")
+        {
+            REQUIRE(file.advise(access_advice::sequential) == file.is_mapped());
+        }
+    }
+
+    GIVEN("an empty file")
+    {
+        {
+            const std::ofstream fs{path, std::ios::binary};
+        }
+
+        const mapped_file file{path};
+
+        THEN("the view is empty") { REQUIRE(file.text().empty()); }
+    }
+
+#if __has_include(<sys/stat.h>)
+    GIVEN("a fifo holding more than one read")
+    {
+        std::filesystem::remove(path);
+        REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+
+        string content;
+
+        for(auto i = 0; i < 20'000; ++i) content += to_string(i) + '\n';
+
+        // opening either end blocks until the other end is opened
+        jthread writer{
+            [&]
+            {
+                std::ofstream fs{path, std::ios::binary};
+                fs << content;
+            }
+        };
+
+        const mapped_file file{path};
+
+        writer.join();
+        std::filesystem::remove(path);
+
+        THEN("it is read whole instead of mapped")
+        {
+            REQUIRE_FALSE(file.is_mapped());
+            REQUIRE(file.text() == content);
+        }
+    }
+#endif
+
+    GIVEN("a regular file reporting size 0")
+    {
+        const std::filesystem::path status = "/proc/self/status";
+
+        if(std::filesystem::exists(status))
+        {
+            const mapped_file file{status};
+
+            THEN("it is read whole instead of mapped")
+            {
+                REQUIRE(std::filesystem::file_size(status) == 0);
+                REQUIRE_FALSE(file.is_mapped());
+                REQUIRE(file.text().starts_with("Name:"));
+                REQUIRE(file.text().ends_with('\n'));
+                REQUIRE(file.text().find("\nnonvoluntary_ctxt_switches:") != string_view::npos);
+            }
+        }
+    }
+
+    GIVEN("a missing file")
+    {
+        std::filesystem::remove(path);
+
+        THEN("opening throws")
+        {
+            REQUIRE_THROWS_AS(mapped_file{path}, std::filesystem::filesystem_error);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#include "stdsharp/execution/thread_pool.h"
+#include "stdsharp/fstream/parallel_read.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <fstream>
+#include <list>
+
+STDSHARP_TEST_NAMESPACES;
+
+namespace
+{
+    auto write_file(const string& content)
+    {
+        auto path = std::filesystem::temp_directory_path() / "stdsharp_parallel_read.txt";
+        std::ofstream{path} << content;
+        return path;
+    }
+}
+
+SCENARIO("parallel read all", "[fstream][parallel_read]")
+{
+    thread_pool pool{4};
+    const parallel_policy policy{pool, 4, 16};
+
+    GIVEN("a file of many integers")
+    {
+        string content;
+
+        for(auto i = 0; i < 1000; ++i)
+            content += std::to_string(i * 7919 - 5000) + (i % 7 == 0 ? '\n' : ' ');
+
+        const auto path = write_file(content);
+
+        THEN("values are read in order like read_all")
+        {
+            REQUIRE(parallel_read_all<long>(policy, path) == read_all<long>(path));
+            REQUIRE(parallel_read_all<long>(policy, path).size() == 1000);
+        }
+
+        THEN("other containers are filled too")
+        {
+            list<long> values;
+
+            read_all_to_container<long>(values, path);
+
+            REQUIRE(parallel_read_all<long, list<long>>(policy, path) == values);
+        }
+    }
+
+    GIVEN("a file with a non number token in the middle")
+    {
+        string content;
+
+        for(auto i = 0; i < 200; ++i) content += std::to_string(i) + ' ';
+        content += "x ";
+        for(auto i = 0; i < 200; ++i) content += std::to_string(i) + ' ';
+
+        const auto path = write_file(content);
+
+        THEN("reading stops at the token")
+        {
+            REQUIRE(parallel_read_all<int>(policy, path) == read_all<int>(path));
+            REQUIRE(parallel_read_all<int>(policy, path).size() == 200);
+        }
+    }
+
+    GIVEN("an empty file")
+    {
+        const auto path = write_file("");
+
+        THEN("nothing is read") { REQUIRE(parallel_read_all<int>(policy, path).empty()); }
+    }
+}
+
+TEST_CASE("parallel read all benchmark", "[.][benchmark][fstream]")
+{
+    string content;
+
+    for(auto i = 0; i < 1'000'000; ++i) content += std::to_string(i * 7919) + ' ';
+
+    const auto path = write_file(content);
+    thread_pool pool;
+    const parallel_policy policy{pool};
+
+    BENCHMARK("read_all") { return read_all<long long>(path); };
+
+    BENCHMARK("parallel_read_all") { return parallel_read_all<long long>(policy, path); };
+}
@@ -0,0 +1,163 @@
+#include "stdsharp/lazy_cell.h"
+#include "test.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+STDSHARP_TEST_NAMESPACES;
+
+SCENARIO("lazy cell", "[lazy_cell]")
+{
+    GIVEN("two inputs and derived cells depending on them")
+    {
+        cell_graph graph;
+        input_cell<int> a{graph, 1};
+        input_cell<int> b{graph, 2};
+        auto sum_invoked = 0u;
+        auto double_invoked = 0u;
+
+        derived_cell sum{
+            graph,
+            [&]
+            {
+                ++sum_invoked;
+                return a.get() + b.get();
+            }
+        };
+        derived_cell doubled{
+            graph,
+            [&]
+            {
+                ++double_invoked;
+                return sum.get() * 2;
+            }
+        };
+
+        REQUIRE(doubled.get() == 6);
+        REQUIRE(sum_invoked == 1);
+        REQUIRE(doubled.height() == 2);
+        REQUIRE(sum.dependencies().size() == 2);
+
+        WHEN("get again without changes")
+        {
+            REQUIRE(doubled.get() == 6);
+
+            THEN("nothing is recomputed")
+            {
+                REQUIRE(sum_invoked == 1);
+                REQUIRE(double_invoked == 1);
+            }
+        }
+
+        WHEN("set an input to the same value")
+        {
+            a.set(1);
+
+            THEN("no cell is invalidated") { REQUIRE(!sum.dirty()); }
+        }
+
+        WHEN("set an input and recompute the graph")
+        {
+            b.set(3);
+
+            REQUIRE(sum.dirty());
+            REQUIRE(doubled.dirty());
+
+            graph.recompute();
+
+            THEN("each dependent is recomputed once")
+            {
+                REQUIRE(sum.cget() == 4);
+                REQUIRE(doubled.cget() == 8);
+                REQUIRE(sum_invoked == 2);
+                REQUIRE(double_invoked == 2);
+            }
+        }
+
+        WHEN("set an input and get the derived cell many times without recompute")
+        {
+            for(auto i = 0; i < 1000; ++i)
+            {
+                a.set(i);
+                REQUIRE(doubled.get() == (i + 2) * 2);
+            }
+
+            THEN("each cell is queued at most once")
+            {
+                REQUIRE(graph.dirty_count() <= 2);
+
+                graph.recompute();
+
+                REQUIRE(graph.dirty_count() == 0);
+                REQUIRE(sum_invoked == 1001);
+                REQUIRE(double_invoked == 1001);
+            }
+        }
+    }
+
+    GIVEN("a derived cell with conditional dependencies")
+    {
+        cell_graph graph;
+        input_cell<bool> condition{graph, true};
+        input_cell<int> a{graph, 1};
+        input_cell<int> b{graph, 2};
+        derived_cell selected{graph, [&] { return condition.get() ? a.get() : b.get(); }};
+
+        REQUIRE(selected.get() == 1);
+
+        WHEN("change the unread input")
+        {
+            b.set(3);
+
+            THEN("the cell stays valid") { REQUIRE(!selected.dirty()); }
+        }
+    }
+}
+
+TEST_CASE("lazy cell incremental tick", "[.][benchmark][lazy_cell]")
+{
+    constexpr auto input_count = 100'000;
+    constexpr auto fan_in = 4;
+    constexpr auto changed_per_tick = input_count / 100;
+
+    cell_graph graph;
+    vector<unique_ptr<input_cell<int>>> inputs;
+    vector<unique_ptr<derived_cell<function<int()>>>> derived;
+
+    for(auto i = 0; i < input_count; ++i)
+        inputs.emplace_back(make_unique<input_cell<int>>(graph, i));
+
+    for(auto i = 0; i < input_count; ++i)
+        derived.emplace_back(make_unique<derived_cell<function<int()>>>(
+            graph,
+            [&inputs, i]
+            {
+                auto sum = 0;
+                for(auto j = 0; j < fan_in; ++j) sum += inputs[(i + j) % input_count]->get();
+                return sum;
+            }
+        ));
+
+    graph.recompute();
+
+    auto tick = 0;
+
+    BENCHMARK("incremental recompute")
+    {
+        ++tick;
+        for(auto i = 0; i < changed_per_tick; ++i)
+            inputs[(i * 97 + tick) % input_count]->set(tick);
+        graph.recompute();
+        return graph.dirty_count();
+    };
+
+    BENCHMARK("full recompute")
+    {
+        ++tick;
+        for(const auto& input : inputs) input->set(tick);
+        graph.recompute();
+
+        auto sum = 0;
+        for(const auto& cell : derived) sum += cell->cget();
+        return sum;
+    };
+}
@@ -1,6 +1,8 @@
 #include "stdsharp/synchronizer.h"
 #include "test.h"
 
+#include <future>
+
 STDSHARP_TEST_NAMESPACES;
 
 SCENARIO("synchronizer", "[synchronizer]")
@@ -36,4 +38,58 @@ SCENARIO("synchronizer", "[synchronizer]")
     synchronizer syn;
     int i{};
     [[maybe_unused]] auto&& [value, lock] = syn.read_with(i);
-}
\ No newline at end of file
+}
+
+SCENARIO("synchronize multiple synchronizers", "[synchronizer]")
+{
+    using synchronizer = synchronizer<shared_timed_mutex>;
+
+    GIVEN("two synchronizers")
+    {
+        synchronizer from_syn;
+        synchronizer to_syn;
+        int from = 1;
+        int to = 0;
+
+        WHEN("acquire shared and exclusive access at once")
+        {
+            auto [src, dst] = synchronize(
+                from_syn.read_with(from, defer_lock),
+                to_syn.write_with(to, defer_lock)
+            );
+
+            THEN("both locks are owned")
+            {
+                REQUIRE(src.lock.owns_lock());
+                REQUIRE(dst.lock.owns_lock());
+
+                dst.value = src.value;
+                REQUIRE(to == 1);
+            }
+        }
+
+        WHEN("try to acquire with deadline while the destination is exclusively held")
+        {
+            [[maybe_unused]] auto&& [value, lock] = to_syn.write_with(to);
+
+            const auto acquired = async(
+                                      launch::async,
+                                      [&]
+                                      {
+                                          return try_synchronize_for(
+                                                     1ms,
+                                                     from_syn.read_with(from, defer_lock),
+                                                     to_syn.write_with(to, defer_lock)
+                                          )
+                                              .has_value();
+                                      }
+            ).get();
+
+            THEN("acquisition times out and nothing stays locked")
+            {
+                REQUIRE(!acquired);
+                REQUIRE(try_synchronize_for(0ms, from_syn.write_with(from, defer_lock)));
+            }
+        }
+    }
+}